@@ -0,0 +1,34 @@
+/***************************************************************************//**
+ * @file
+ * @brief Binary-angle trigonometry backed by a flash lookup table
+ *******************************************************************************
+ * Angles are binary angle units (BAM): the full circle maps onto the 16 bit
+ * range, so wrap-around is free and a quarter turn is ANGLE_QUARTER. Sine and
+ * cosine come from a quarter-wave Q16.16 table with linear interpolation, so
+ * aiming and cannon drawing cost a table read instead of a libm call.
+ ******************************************************************************/
+
+#ifndef ANGLE_H
+#define ANGLE_H
+#include <stdint.h>
+#include "fixedpoint.h"
+
+typedef uint16_t angle_t;
+
+#define ANGLE_QUARTER   ((angle_t)0x4000)
+#define ANGLE_HALF      ((angle_t)0x8000)
+
+// Compile time conversion from whole degrees
+#define ANGLE_FROM_DEGREES(deg) ((angle_t)(((int32_t)(deg) * 65536 / 360) & 0xFFFF))
+
+angle_t angleFromDegrees(int32_t degrees);
+int32_t angleToDegrees(angle_t angle);
+
+fix16_t angleSin(angle_t angle);
+fix16_t angleCos(angle_t angle);
+
+// Single precision accessors for code that still works in float
+float angleSinf(angle_t angle);
+float angleCosf(angle_t angle);
+
+#endif // ANGLE_H
@@ -33,57 +33,29 @@
 #include "os.h"
 #include "stdio.h"
 #include "FIFO.h"
+#include "fixedpoint.h"
+#include "angle.h"
+#include "physics.h"
+#include "snapshot.h"
+#include "timestep.h"
+#include "game.h"
+#include "recorder.h"
+#include "cycleprof.h"
+#include "framebuf.h"
+#include "lcdlines.h"
+#include "render.h"
+#include "perfhud.h"
+#include "framerate.h"
+#include "lcdflush.h"
+#include "lcdspi.h"
+#include "app.h"
+#if CYCLE_PROFILING
+#include "SEGGER_RTT.h"
+#endif
 
 // #define TEST_MODE // Comment out to disable test mode
 
-#define PHYSICS_VERSION 1
-
-struct castleConstants {
-    int castleHeight; // cm
-    int foundationHitsRequired;
-    int foundationDepth; // cm
-};
-enum limitingMethod {AlwaysOne, MaxInFlight, PeriodicThrowTime};
-struct satchelConstants {
-    int limitingMethod;
-    int satchelDisplayDiameter; // Pixels
-    int throwPeriod; // in amount of physics periods
-    int maxInFlight; // amount of satchels allowed in flight
-    int maxInFlightPeriod; // in amount of physics periods
-    int satchelWeight;
-};
-struct platformConstants {
-    int maxPlatformForce; // Newtons
-    int platformMass; // KG
-    int platformLength; // cm
-    int maxPlatformBounceSpeed; // cm/s
-    int maxPlatformSpeed; // cm/s
-};
-struct shieldConstants {
-    int shieldEffectiveRange; // cm
-    int shieldActivationEnergy; // KJ
-};
-struct railGunConstants{
-    int railgunAngle; // radians
-    int shotMass; // kg
-    int shotRadius; // pixels
-};
-struct generatorCosntants{
-    int energyCapacity; // KJ
-    float maxShotPower; // watts
-};
-struct physicsConstants {
-    int physicsPeriod; // ms
-    int sliderPeriod; // ms
-    int lcdPeriod; // ms
-    int canyonSize; // cm
-    struct castleConstants castleConst;
-    struct satchelConstants satchelConst;
-    struct platformConstants platformConst;
-    struct shieldConstants shieldConst;
-    struct railGunConstants railGunConst;
-    struct generatorCosntants generatorConst;
-} physConsts;
+const struct physicsConstants *physConsts; // The running game's profile
 
 OS_MUTEX buttonStructMutex;
 OS_SEM buttonSem;
@@ -99,9 +71,13 @@ struct sliderState sliderState;
 OS_MUTEX sliderMutex;
 OS_SEM sliderSem;
 
-OS_SEM LCDSem;
+OS_SEM LCDSem; // Posted on a game state change so the display redraws without waiting for its period
 
-OS_SEM gameEndSem; // Used to block tasks when the game is over. Will only post if intending to restart.
+// The game state, broadcast by the physics task: one flag per states enum value, exactly one set.
+// Tasks pend on the state they run in and wake once when it is entered.
+OS_FLAG_GRP gameStateFlags;
+#define GAME_STATE_FLAG(state) ((OS_FLAGS)1u << (state))
+#define GAME_STATE_FLAGS_ALL   (GAME_STATE_FLAG(menu) | GAME_STATE_FLAG(active) | GAME_STATE_FLAG(win) | GAME_STATE_FLAG(fail))
 
 struct buttonStateStruct {
   bool button0State;
@@ -110,179 +86,10 @@ struct buttonStateStruct {
   bool button1Change;
 };
 
-// Variables to allow for easy tuning of game
-int gravity = -10;
-int screenSize = 127; // Actually 128 but 0 indexed
-struct physicsConstants physicsConstantsInit(void);
-struct physicsConstants physicsConstantsInit(void) {
-    // struct physicsConstants val;
-    if (PHYSICS_VERSION == 1) {
-        struct physicsConstants val = { // Normal Version
-            .physicsPeriod = 50,
-            .sliderPeriod = 100,
-            .lcdPeriod = 150,
-            .canyonSize = screenSize,
-            .castleConst = {
-                .castleHeight = screenSize * .75,
-                .foundationHitsRequired = 3,
-                .foundationDepth = 21
-            },
-            .satchelConst = {
-                .limitingMethod = AlwaysOne,
-                .satchelDisplayDiameter = 7,
-                .throwPeriod = 5,
-                .maxInFlight = 2,
-                .maxInFlightPeriod = 10,
-                .satchelWeight = 1000,
-            },
-            .platformConst = {
-                .maxPlatformForce = 5000,
-                .platformMass = 100,
-                .platformLength = 16,
-                .maxPlatformBounceSpeed = 5000,
-                .maxPlatformSpeed = 5000
-            },
-            .shieldConst = {
-                .shieldEffectiveRange = 20,
-                .shieldActivationEnergy = 30
-            },
-            .railGunConst = {
-                .railgunAngle = 3*3.1415/4 * 100,
-                .shotMass = 50,
-                .shotRadius = 5
-            },
-            .generatorConst = {
-                .energyCapacity = 50,
-                .maxShotPower = 20
-            }
-        };
-        // Scale the physconsts to the screen size using ratio
-        // Allows for any desired values but immediately scales them to the screen size
-        int ratio = val.canyonSize / screenSize;
-        val.canyonSize = screenSize;
-        val.castleConst.castleHeight = val.castleConst.castleHeight / ratio;
-        val.castleConst.foundationDepth = val.castleConst.foundationDepth / ratio;
-        val.satchelConst.satchelDisplayDiameter = val.satchelConst.satchelDisplayDiameter / ratio;
-        val.platformConst.platformLength = val.platformConst.platformLength / ratio;
-        val.platformConst.maxPlatformForce = val.platformConst.maxPlatformForce / ratio; // maybe
-        val.platformConst.maxPlatformBounceSpeed = val.platformConst.maxPlatformBounceSpeed / ratio;
-        val.platformConst.maxPlatformSpeed = val.platformConst.maxPlatformSpeed / ratio;
-        val.shieldConst.shieldEffectiveRange = val.shieldConst.shieldEffectiveRange / ratio;
-        val.railGunConst.shotRadius = val.railGunConst.shotRadius / ratio;
-        return val;
-    } else if (PHYSICS_VERSION == 2) {
-        struct physicsConstants val = { // Suggested Version
-            .physicsPeriod = 50,
-            .sliderPeriod = 100,
-            .lcdPeriod = 150,
-            .canyonSize = 100000,
-            .castleConst = {
-                .castleHeight = 5000,
-                .foundationHitsRequired = 2,
-                .foundationDepth = 5000
-            },
-            .satchelConst = {
-                .limitingMethod = AlwaysOne,
-                .satchelDisplayDiameter = 10,
-                .throwPeriod = 1000,
-                .maxInFlight = 2,
-                .maxInFlightPeriod = 500,
-                .satchelWeight = 1000
-            },
-            .platformConst = {
-                .maxPlatformForce = 20000000,
-                .platformMass = 100,
-                .platformLength = 10000,
-                .maxPlatformBounceSpeed = 50000,
-                .maxPlatformSpeed = 50000
-            },
-            .shieldConst = {
-                .shieldEffectiveRange = 15000,
-                .shieldActivationEnergy = 30000
-            },
-            .railGunConst = {
-                .railgunAngle = 800,
-                .shotMass = 50,
-                .shotRadius = 5
-            },
-            .generatorConst = {
-                .energyCapacity = 50000,
-                .maxShotPower = 20000
-            }
-        };
-        // Scale the physconsts to the screen size using ratio
-        // Allows for any desired values but immediately scales them to the screen size
-        int ratio = val.canyonSize / screenSize;
-        val.canyonSize = screenSize;
-        val.castleConst.castleHeight = val.castleConst.castleHeight / ratio;
-        val.castleConst.foundationDepth = val.castleConst.foundationDepth / ratio;
-        val.satchelConst.satchelDisplayDiameter = val.satchelConst.satchelDisplayDiameter / ratio;
-        val.platformConst.platformLength = val.platformConst.platformLength / ratio;
-        val.platformConst.maxPlatformForce = val.platformConst.maxPlatformForce / ratio; // maybe
-        val.platformConst.maxPlatformBounceSpeed = val.platformConst.maxPlatformBounceSpeed / ratio;
-        val.platformConst.maxPlatformSpeed = val.platformConst.maxPlatformSpeed / ratio;
-        val.shieldConst.shieldEffectiveRange = val.shieldConst.shieldEffectiveRange / ratio;
-        val.railGunConst.shotRadius = val.railGunConst.shotRadius / ratio;
-        return val;
-    } else if (PHYSICS_VERSION == 3) { 
-        struct physicsConstants val = { // Normal Version
-            .physicsPeriod = 50,
-            .sliderPeriod = 100,
-            .lcdPeriod = 150,
-            .canyonSize = screenSize,
-            .castleConst = {
-                .castleHeight = screenSize * .75,
-                .foundationHitsRequired = 3,
-                .foundationDepth = 20
-            },
-            .satchelConst = {
-                .limitingMethod = AlwaysOne,
-                .satchelDisplayDiameter = 7,
-                .throwPeriod = 10,
-                .maxInFlight = 2,
-                .maxInFlightPeriod = 10,
-                .satchelWeight = 1000
-            },
-            .platformConst = {
-                .maxPlatformForce = 5000,
-                .platformMass = 100,
-                .platformLength = 16,
-                .maxPlatformBounceSpeed = 5000,
-                .maxPlatformSpeed = 5000
-            },
-            .shieldConst = {
-                .shieldEffectiveRange = 20,
-                .shieldActivationEnergy = 30
-            },
-            .railGunConst = {
-                .railgunAngle = 3*3.1415/4 * 100,
-                .shotMass = 50,
-                .shotRadius = 5
-            },
-            .generatorConst = {
-                .energyCapacity = 50,
-                .maxShotPower = 20
-            },
-        };
-        // Scale the physconsts to the screen size using ratio
-        // Allows for any desired values but immediately scales them to the screen size
-        int ratio = val.canyonSize / screenSize;
-        val.canyonSize = screenSize;
-        val.castleConst.castleHeight = val.castleConst.castleHeight / ratio;
-        val.castleConst.foundationDepth = val.castleConst.foundationDepth / ratio;
-        val.satchelConst.satchelDisplayDiameter = val.satchelConst.satchelDisplayDiameter / ratio;
-        val.platformConst.platformLength = val.platformConst.platformLength / ratio;
-        val.platformConst.maxPlatformForce = val.platformConst.maxPlatformForce / ratio; // maybe
-        val.platformConst.maxPlatformBounceSpeed = val.platformConst.maxPlatformBounceSpeed / ratio;
-        val.platformConst.maxPlatformSpeed = val.platformConst.maxPlatformSpeed / ratio;
-        val.shieldConst.shieldEffectiveRange = val.shieldConst.shieldEffectiveRange / ratio;
-        val.railGunConst.shotRadius = val.railGunConst.shotRadius / ratio;
-        return val;
-    }
-}
 
 
-OS_SEM physicsSem;
+
+OS_SEM physicsSem; // Posted on any input change, wakes an idle physics task
 #define  PHYSICS_TASK_PRIO            21u  /*   Task Priority.                 */
 #define  PHYSICS_TASK_STK_SIZE       256u  /*   Stack size in CPU_STK.         */
 OS_TCB   physicsTaskTCB;                            /*   Task Control Block.   */
@@ -313,363 +120,386 @@ void  physicsTaskCreate (void)
         /* Handle error on task creation. */
     }
 }
-OS_MUTEX physicsStructMutex;
-enum objectType {empty, player, satchel, shot};
-struct physicsData {
-    int objectType;
-    int mass;
-    float x;
-    float y;
-    float xVel;
-    float yVel;
-    float xAcc;
-    float yAcc;
-    int xForce;
-    int yForce;
-} physDataArray[10];
-enum states {menu, active, win, fail};
-struct gameData {
-    int state; // use states enum
-    float energy;
-    float shotCharge;
-    int foundationDamage;
-    bool evacComplete;
-    bool shieldActive;
-    int satchelsThrown;
-    int shieldsActivated;
-    int usefulShields;
-    int shotsFired;
-} gameData;
+// Current railgun aim. Read once per shot by physics and once per frame by the display.
+volatile angle_t railgunAim;
 /***************************************************************************//**
  * @brief
- *   Spawns satchel. Called by physics task.
+ *   Sets the railgun aim. Safe to call from any task; the next shot and frame use it.
  ******************************************************************************/
-void spawnSatchel(struct physicsData *phys);
-void spawnSatchel(struct physicsData *phys) {
-    // Decide random landing spot. Allow for beyond canyon size to give a chance to bounce off of wall
-    int landingSpot = rand() % (int)(physConsts.canyonSize / 3);
-    if (rand() % 2) { // Randomly make landing spot negative
-        landingSpot = landingSpot * -1;
-    }
-    landingSpot = landingSpot + physDataArray[0].x; // Landing spot is relative to player
-    // Calculate random flight duration from 1000ms to 5000ms
-    float flightDuration = rand() % 4000 + 1000;
-    flightDuration = flightDuration / 1000;
-    // Calculate X speed to arrive in flight duration time
-    float xSpeed = landingSpot / flightDuration;
-    // Calculate Y speed to arrive in flight duration time
-    float ySpeed = (-physConsts.castleConst.castleHeight / flightDuration) - (gravity * flightDuration / 2);
-
-    phys->objectType = satchel;
-    phys->x = 0;
-    phys->y = physConsts.castleConst.castleHeight;
-    phys->xVel = xSpeed;
-    phys->yVel = ySpeed;
-    phys->xAcc = 0;
-    phys->yAcc = gravity;
-    phys->xForce = 0;
-    phys->yForce = 0;
-    phys->mass = physConsts.satchelConst.satchelWeight;
+void railgunSetAngle(angle_t angle)
+{
+    railgunAim = angle;
+    LCD_invalidateCannon();
 }
 /***************************************************************************//**
  * @brief
- *   Clears physics data. Called by physics task whenever an object is destroyed.
+ *   Returns the current railgun aim.
  ******************************************************************************/
-void clearPhysicsData(struct physicsData *physData);
-void clearPhysicsData(struct physicsData *physData) {
-    physData->objectType = empty;
-    physData->x = 0;
-    physData->y = 0;
-    physData->xVel = 0;
-    physData->yVel = 0;
-    physData->xAcc = 0;
-    physData->yAcc = 0;
-    physData->xForce = 0;
-    physData->yForce = 0;
-    physData->mass = 0;
+angle_t railgunGetAngle(void)
+{
+    return railgunAim;
 }
+// Owned by the physics task. Other tasks read the published copy in physicsSnapshot.
+struct gameState physicsState;
+struct frameSnapshot physicsSnapshot;
+struct fixedStep physicsTimestep;
+#define PHYSICS_MAX_CATCH_UP 4 // steps run back to back after a stall before time is dropped
+volatile bool evacComplete; // Set by LED1Task, passed to the engine with the other inputs
+// Every game is recorded. To replay one, call physicsExportRecording() from the debugger, or load
+// a record from the host into replayBuffer and set replayLength, any time before starting a game
+// from the menu. physicsTask checks replayLength as each game starts: that game then plays back
+// the recorded inputs, with the recorded seed and constants, instead of the live ones. Starting
+// it clears replayLength, so the game after is live again.
+struct recorder inputRecorder;
+uint8_t replayBuffer[RECORDER_RING_BYTES];
+volatile uint32_t replayLength;
+volatile int replayResult; // 1 replay reproduced the recorded outcome, -1 it did not, 0 none yet
+// While nothing moves the physics task sleeps until an input changes or the next step that does
+// something, and fast-forwards the steps in between. Read the counters with the debugger.
+#define PHYSICS_MIN_IDLE_STEPS 2 // shorter stretches are not worth a pend
+struct physicsIdleStats {
+    uint32_t wakeups; // times the physics task woke, to step or after idling
+    uint32_t idlePeriods; // times it slept through steps
+    uint32_t inputWakeups; // idle periods ended early by an input change
+    uint32_t minuteStart; // OS tick the current minute began
+    uint32_t minuteWakeups;
+    uint32_t minuteSkipped;
+    uint32_t wakeupsPerMinute; // over the last full minute
+    uint32_t skippedPerMinute; // steps fast-forwarded over the last full minute
+};
+volatile struct physicsIdleStats physicsIdle;
+// Time spent in physicsStep(), for the performance HUD, on the cycle counter of lcdSpiClock().
+// The display task takes the mean step over each HUD sample from how much both grew.
+struct physicsStepTime {
+    uint32_t steps;
+    uint32_t cycles; // wraps; only differences are used
+};
+volatile struct physicsStepTime physicsStepTime;
+#if CYCLE_PROFILING
+// Phase histogram report, one line at a time to RTT terminal 0
+static void cycleReportLine(const char *line)
+{
+    SEGGER_RTT_WriteString(0, line);
+}
+#endif
 /***************************************************************************//**
  * @brief
- *   Physics task. Handles all physics calculations.
+ *   Counts one physics task wakeup and rolls the per minute counters over.
  ******************************************************************************/
-void  physicsTask (void  *p_arg)
+static void physicsCountWakeup(uint32_t now, uint32_t skipped)
 {
-    /* Use argument. */
-   (void)&p_arg;
-   RTOS_ERR     err;
-    struct gameData localDat = {
-        .state = menu, // use states enum
-        .energy = physConsts.generatorConst.energyCapacity,
-        .shotCharge = 0,
-        .foundationDamage = 0,
-        .evacComplete = false,
-        .satchelsThrown = 0,
-        .shieldsActivated = 0,
-        .usefulShields = 0,
-        .shotsFired = 0
-    };
-    gameData = localDat;
-    for (int i = 0; i < 10; i++) {
-        physDataArray[i].objectType = empty;
-        physDataArray[i].mass = 0;
-        physDataArray[i].x = 0;
-        physDataArray[i].y = 0;
-        physDataArray[i].xVel = 0;
-        physDataArray[i].yVel = 0;
-        physDataArray[i].xAcc = 0;
-        physDataArray[i].yAcc = 0;
-        physDataArray[i].xForce = 0;
-        physDataArray[i].yForce = 0;
+    RTOS_ERR err;
+    physicsIdle.wakeups++;
+    physicsIdle.minuteWakeups++;
+    physicsIdle.minuteSkipped += skipped;
+    if (now - physicsIdle.minuteStart >= 60u * OSTimeTickRateHzGet(&err)) {
+        physicsIdle.wakeupsPerMinute = physicsIdle.minuteWakeups;
+        physicsIdle.skippedPerMinute = physicsIdle.minuteSkipped;
+        physicsIdle.minuteWakeups = 0;
+        physicsIdle.minuteSkipped = 0;
+        physicsIdle.minuteStart = now;
     }
-    physDataArray[0].objectType = player;
-    physDataArray[0].x = physConsts.canyonSize / 2;
-    physDataArray[0].y = 0;
-    physDataArray[0].mass = physConsts.platformConst.platformMass;
-    bool charging = false;
-    int timer = 0;
-    gameData.state = active;
-    struct physicsData localDataArray[10]; // Local copy of physics data to minimize mutex time
-
-   while (DEF_TRUE) {
-        while (gameData.state != active) {// stop when game not running. Used to block task
-            OSSemPend(&gameEndSem, 0, OS_OPT_PEND_BLOCKING, DEF_NULL, &err);
-            while (err.Code != RTOS_ERR_NONE) {}
-        }
-        // Wait for physics period
-        OSTimeDlyHMSM(0, 0, 0, physConsts.physicsPeriod, OS_OPT_TIME_DLY, &err);
-       while (err.Code != RTOS_ERR_NONE) {}
-        OSMutexPend(&physicsStructMutex, 0, OS_OPT_PEND_BLOCKING, DEF_NULL, &err);
+}
+/***************************************************************************//**
+ * @brief
+ *   Copies a finished game's record into replayBuffer, 0 being the latest.
+ *   Read it out with the debugger, or leave it there for the next game
+ *   started from the menu to replay.
+ ******************************************************************************/
+uint32_t physicsExportRecording(unsigned newest)
+{
+    replayLength = recorderExport(&inputRecorder, newest, replayBuffer, sizeof(replayBuffer));
+    return replayLength;
+}
+/***************************************************************************//**
+ * @brief
+ *   Samples the slider, buttons and aim into one set of step inputs.
+ ******************************************************************************/
+static void readInputs(struct gameInputs *inputs)
+{
+    RTOS_ERR err;
+    OSMutexPend(&sliderMutex, 0, OS_OPT_PEND_BLOCKING, DEF_NULL, &err);
+    inputs->farLeft = sliderState.farLeft;
+    inputs->left = sliderState.left;
+    inputs->right = sliderState.right;
+    inputs->farRight = sliderState.farRight;
+    OSMutexPost(&sliderMutex, OS_OPT_POST_NONE, &err);
+    OSMutexPend(&buttonStructMutex, 0, OS_OPT_PEND_BLOCKING, DEF_NULL, &err);
+    while (err.Code != RTOS_ERR_NONE) {}
+    inputs->charge = buttonStates.button0State;
+    inputs->shield = buttonStates.button1State == 1 && buttonStates.button1Change == 1;
+    OSMutexPost(&buttonStructMutex, OS_OPT_POST_NONE, &err);
+    while (err.Code != RTOS_ERR_NONE) {}
+    inputs->evacComplete = evacComplete;
+    inputs->aim = railgunAim;
+}
+/***************************************************************************//**
+ * @brief
+ *   Broadcasts a game state change to every task pending on it.
+ ******************************************************************************/
+static void gameStateBroadcast(int state)
+{
+    RTOS_ERR err;
+    OSFlagPost(&gameStateFlags, GAME_STATE_FLAGS_ALL & ~GAME_STATE_FLAG(state), OS_OPT_POST_FLAG_CLR, &err);
+    while (err.Code != RTOS_ERR_NONE) {}
+    OSFlagPost(&gameStateFlags, GAME_STATE_FLAG(state), OS_OPT_POST_FLAG_SET, &err);
+    while (err.Code != RTOS_ERR_NONE) {}
+    OSSemPost(&LCDSem, OS_OPT_POST_1, &err);
+    while (err.Code != RTOS_ERR_NONE) {}
+}
+/***************************************************************************//**
+ * @brief
+ *   Blocks until the game is in the given state. Returns at once if it is.
+ ******************************************************************************/
+static void gameStateWait(int state)
+{
+    RTOS_ERR err;
+    OSFlagPend(&gameStateFlags, GAME_STATE_FLAG(state), 0, OS_OPT_PEND_FLAG_SET_ANY | OS_OPT_PEND_BLOCKING, DEF_NULL, &err);
+    while (err.Code != RTOS_ERR_NONE) {}
+}
+/***************************************************************************//**
+ * @brief
+ *   Samples both buttons under the button mutex.
+ ******************************************************************************/
+static void readButtons(bool *button0, bool *button1)
+{
+    RTOS_ERR err;
+    OSMutexPend(&buttonStructMutex, 0, OS_OPT_PEND_BLOCKING, DEF_NULL, &err);
+    while (err.Code != RTOS_ERR_NONE) {}
+    *button0 = buttonStates.button0State;
+    *button1 = buttonStates.button1State;
+    OSMutexPost(&buttonStructMutex, OS_OPT_POST_NONE, &err);
+    while (err.Code != RTOS_ERR_NONE) {}
+}
+/***************************************************************************//**
+ * @brief
+ *   Profile menu, run by the physics task before each game. BTN1 moves to
+ *   the next profile; pressing and releasing BTN0 starts the game with the
+ *   selected one. Buttons already held when the menu opens are ignored.
+ ******************************************************************************/
+static int physicsMenu(int profile)
+{
+    RTOS_ERR err;
+    struct gameData menuData = {.state = menu, .profile = profile};
+    bool button0Was, button1Was;
+    bool startPressed = false;
+    snapshotPublish(&physicsSnapshot, physicsState.objects, physicsState.previous, &menuData, OSTimeGet(&err), 1);
+    gameStateBroadcast(menu);
+    readButtons(&button0Was, &button1Was);
+    while (DEF_TRUE) {
+        OSTimeDlyHMSM(0, 0, 0, physicsProfiles[menuData.profile].consts.sliderPeriod, OS_OPT_TIME_DLY, &err);
         while (err.Code != RTOS_ERR_NONE) {}
-        // Copy physics data to local array
-        for (int i = 0; i < 10; i++) {
-            localDataArray[i].mass = physDataArray[i].mass;
-            localDataArray[i].objectType = physDataArray[i].objectType;
-            localDataArray[i].x = physDataArray[i].x;
-            localDataArray[i].y = physDataArray[i].y;
-            localDataArray[i].xVel = physDataArray[i].xVel;
-            localDataArray[i].yVel = physDataArray[i].yVel;
-            localDataArray[i].xAcc = physDataArray[i].xAcc;
-            localDataArray[i].yAcc = physDataArray[i].yAcc;
-            localDataArray[i].xForce = physDataArray[i].xForce;
-            localDataArray[i].yForce = physDataArray[i].yForce;
+        bool button0, button1;
+        readButtons(&button0, &button1);
+        if (button1 && !button1Was) {
+            menuData.profile = (menuData.profile + 1) % PHYSICS_PROFILE_COUNT;
+            snapshotPublish(&physicsSnapshot, physicsState.objects, physicsState.previous, &menuData, OSTimeGet(&err), 1);
+            OSSemPost(&LCDSem, OS_OPT_POST_1, &err);
         }
-        OSMutexPost(&physicsStructMutex, OS_OPT_POST_NONE, &err);
-        OSMutexPend(&sliderMutex, 0, OS_OPT_PEND_BLOCKING, DEF_NULL, &err);
-        // Use slider data to calculate platform force
-        if ((sliderState.farLeft || sliderState.left) && (sliderState.farRight || sliderState.right)) {
-            // do Nothing
-        } else if (sliderState.left) {
-            localDataArray[0].xForce += -physConsts.platformConst.maxPlatformForce / 2;
-        } else if (sliderState.right) {
-            localDataArray[0].xForce += physConsts.platformConst.maxPlatformForce;
-        } else if (sliderState.farLeft) {
-            localDataArray[0].xForce += -physConsts.platformConst.maxPlatformForce;
-        } else if (sliderState.farRight) {
-            localDataArray[0].xForce += physConsts.platformConst.maxPlatformForce / 2;
-        } else { // no slider input, apply friction
-            if (localDataArray[0].xVel > 0) {
-                localDataArray[0].xForce += -physConsts.platformConst.maxPlatformForce;
-            } else if (localDataArray[0].xVel < 0) {
-                localDataArray[0].xForce += physConsts.platformConst.maxPlatformForce;
-            }
+        startPressed |= button0 && !button0Was;
+        if (!button0 && startPressed) {
+            return menuData.profile;
         }
-        OSMutexPost(&sliderMutex, OS_OPT_POST_NONE, &err);
-        OSMutexPend(&buttonStructMutex, 0, OS_OPT_PEND_BLOCKING, DEF_NULL, &err);
+        button0Was = button0;
+        button1Was = button1;
+    }
+}
+/***************************************************************************//**
+ * @brief
+ *   Holds the game over screen until BTN0 is pressed and released.
+ ******************************************************************************/
+static void physicsWaitRestart(void)
+{
+    RTOS_ERR err;
+    bool button0Was, button1;
+    bool pressed = false;
+    readButtons(&button0Was, &button1);
+    while (DEF_TRUE) {
+        OSTimeDlyHMSM(0, 0, 0, physConsts->sliderPeriod, OS_OPT_TIME_DLY, &err);
         while (err.Code != RTOS_ERR_NONE) {}
-        // Use button data to calculate shot charge
-        if (buttonStates.button0State == 1) { // Start charging
-            charging = true;
-        } else if (buttonStates.button0State == 0 && charging == true) { // Fire shot
-            charging = false;
-            if (gameData.shotCharge > 0) {
-                for (int j = 0; j < 10; j++) {
-                    if (localDataArray[j].objectType == empty) {
-                        localDataArray[j].objectType = shot;
-                        localDataArray[j].x = localDataArray[0].x;
-                        localDataArray[j].y = 1;
-                        localDataArray[j].xVel = (gameData.shotCharge / physConsts.generatorConst.maxShotPower) * 100 * cos(physConsts.railGunConst.railgunAngle * 3.14159 / 180);
-                        localDataArray[j].yVel = -(gameData.shotCharge / physConsts.generatorConst.maxShotPower) * 100 * sin(physConsts.railGunConst.railgunAngle * 3.14159 / 180);
-                        localDataArray[j].xAcc = 0;
-                        localDataArray[j].yAcc = 0;
-                        localDataArray[j].mass = physConsts.railGunConst.shotMass;
-                        localDataArray[0].xForce += 50000;
-                        gameData.shotCharge = 0;
-                        gameData.shotsFired++;
-                        break;
-                    }
-                }
-            }
-        } 
-        // Use button data to calculate shield activation. Destroy all satchels in range        
-        if (buttonStates.button1State == 1 && gameData.energy >= physConsts.shieldConst.shieldActivationEnergy && buttonStates.button1Change == 1) {
-            gameData.energy -= physConsts.shieldConst.shieldActivationEnergy;
-            gameData.shieldsActivated++;
-            gameData.shieldActive = true;
-            for (int i = 1; i < 10; i++) {
-                if (localDataArray[i].objectType == satchel) {
-                    int xDist = localDataArray[i].x - localDataArray[0].x;
-                    xDist = abs(xDist);
-                    int yDist = localDataArray[i].y - localDataArray[0].y;
-                    yDist = abs(yDist);
-                    int distance = sqrt(xDist * xDist + yDist * yDist);
-                    if (distance <= physConsts.shieldConst.shieldEffectiveRange) {
-                        clearPhysicsData(&localDataArray[i]);
-                        gameData.usefulShields++;
-                    }
-                }
-            }
+        bool button0;
+        readButtons(&button0, &button1);
+        pressed |= button0 && !button0Was;
+        if (!button0 && pressed) {
+            return;
         }
-        OSMutexPost(&buttonStructMutex, OS_OPT_POST_NONE, &err);
-        while (err.Code != RTOS_ERR_NONE) {}
-        // If charging, add charge and reduce energy. Otherwise, charge energy
-        if (charging == true && gameData.energy > 0 && gameData.shotCharge < physConsts.generatorConst.maxShotPower) {
-            gameData.shotCharge += physConsts.generatorConst.maxShotPower * (float)physConsts.physicsPeriod / 1.5 / 1000;
-            gameData.energy -= physConsts.generatorConst.maxShotPower * (float)physConsts.physicsPeriod / 1.5 / 1000;
-        } else if (charging == true && gameData.energy == 0) {
-            // Do nothing
-        } else if (charging == false && gameData.energy >= physConsts.generatorConst.energyCapacity) {
-            gameData.energy = physConsts.generatorConst.energyCapacity;
-        } else if (charging == false && gameData.energy <= physConsts.generatorConst.energyCapacity) {
-            gameData.energy += physConsts.generatorConst.maxShotPower * (float)physConsts.physicsPeriod / 1.5 / 1000;
+        button0Was = button0;
+    }
+}
+/***************************************************************************//**
+ * @brief
+ *   Plays one game to its end on a fixed step with the board inputs (or the
+ *   replay) and publishes the result for the display and LED tasks.
+ ******************************************************************************/
+static void physicsPlay(struct replay *replay, bool replaying)
+{
+    RTOS_ERR err;
+    // Fixed step on the OS tick count. The step runs at a steady cadence however long the tick itself takes.
+    uint32_t stepTicks = (physConsts->physicsPeriod * OSTimeTickRateHzGet(&err) + 500) / 1000;
+    stepInit(&physicsTimestep, stepTicks, PHYSICS_MAX_CATCH_UP, OSTimeGet(&err));
+    uint32_t pendingSteps = 0;
+    uint32_t quietSteps = 0;
+    const fix16_t dt = physicsState.step.dt;
+    struct gameInputs inputs;
+    physicsIdle.minuteStart = OSTimeGet(&err);
+    gamePrepareFrame(&physicsState);
+    snapshotPublish(&physicsSnapshot, physicsState.objects, physicsState.previous, &physicsState.game,
+                    physicsTimestep.stateTime, physicsTimestep.stepTicks);
+    gameStateBroadcast(active);
+
+    while (physicsState.game.state == active) {
+        // Nothing moving: sleep until the first step that would do something, or an input change.
+        // The steps slept through are fast-forwarded with the inputs they would have read.
+        if (pendingSteps == 0 && quietSteps >= PHYSICS_MIN_IDLE_STEPS) {
+            uint32_t timeout = stepTicksUntilDue(&physicsTimestep, OSTimeGet(&err)) + quietSteps * physicsTimestep.stepTicks;
+            OSSemPend(&physicsSem, timeout, OS_OPT_PEND_BLOCKING, DEF_NULL, &err);
+            while (err.Code != RTOS_ERR_NONE && err.Code != RTOS_ERR_TIMEOUT) {}
+            physicsIdle.idlePeriods++;
+            physicsIdle.inputWakeups += err.Code == RTOS_ERR_NONE;
+            uint32_t now = OSTimeGet(&err);
+            uint32_t skipped = stepSkip(&physicsTimestep, now, quietSteps);
+            gameSkipSteps(&physicsState, &inputs, skipped);
+            recorderRepeat(&inputRecorder, &inputs, skipped);
+            physicsCountWakeup(now, skipped);
+            quietSteps = 0;
+            pendingSteps = stepAdvance(&physicsTimestep, now); // The step that ended the idle period may be due already
         }
-        // Check if satchel should be spawned
-        switch (physConsts.satchelConst.limitingMethod) {
-          case AlwaysOne:
-              // Check if there is a satchel in the array
-              for (int i = 0; i < 10; i++) {
-                  if (localDataArray[i].objectType == satchel) {
-                      break;
-                  } else if (i == 9) {
-                      // If there is no satchel in the array, create one
-                      for (int i = 0; i < 10; i++) {
-                        if (localDataArray[i].objectType == empty) {
-                            spawnSatchel(&localDataArray[i]);
-                            break;
-                        }
-                      }
-                  }
-              }
-              break;
-          case MaxInFlight:
-              // Check if # of satchels in flight is less than max
-              if(0 == 1) {}; // Allow for compilation due to label error
-              int satchelCount = 0;
-              timer++;
-              for (int i = 0; i < 10; i++) {
-                  if (localDataArray[i].objectType == satchel) {
-                      satchelCount++;
-                  }
-              }
-              if (satchelCount >= physConsts.satchelConst.maxInFlight) {
-                  timer = 0;
-              }
-              if (satchelCount < physConsts.satchelConst.maxInFlight && !(timer % physConsts.satchelConst.maxInFlightPeriod)) { // If there are less than max, create a satchel
-                    for (int i = 0; i < 10; i++) {
-                        if (localDataArray[i].objectType == empty) {
-                            spawnSatchel(&localDataArray[i]);
-                            break;
-                        }
-                    }
-              }
-              break;
-          case PeriodicThrowTime:
-              // Check if it is time to throw a satchel
-              if(0 == 1) {}; // Allow for compilation due to label error
-              if ((timer % physConsts.satchelConst.throwPeriod) == 0) {
-                    for (int i = 0; i < 10; i++) {
-                        if (localDataArray[i].objectType == empty) {
-                            spawnSatchel(&localDataArray[i]);
-                            break;
-                        }
-                    }
-              }
-              timer++;
-              break;
-          default:
-              while (1) {}
-              // Shouldn't be here
-              break;
-        }   
-        // Unique physics calculations for each object type
-        for (int i = 0; i < 10; i++) {
-            if (localDataArray[i].objectType == shot) { // shot physics
-                localDataArray[i].xAcc = localDataArray[i].xForce / localDataArray[i].mass;
-                localDataArray[i].yAcc = localDataArray[i].yForce / localDataArray[i].mass + gravity;
-                localDataArray[i].yVel += localDataArray[i].yAcc * ((float)physConsts.physicsPeriod / 1000);
-                localDataArray[i].xVel += localDataArray[i].xAcc * ((float)physConsts.physicsPeriod / 1000);
-                localDataArray[i].x += localDataArray[i].xVel * ((float)physConsts.physicsPeriod / 1000);
-                localDataArray[i].y += localDataArray[i].yVel * ((float)physConsts.physicsPeriod / 1000);
-                localDataArray[i].yForce = 0; // Forces aren't constant, so they need to be reset
-                localDataArray[i].xForce = 0; // Forces aren't constant, so they need to be reset
-                // Check if the shot has hit castle
-                if (localDataArray[i].x <= 0  && localDataArray[i].y >= physConsts.castleConst.castleHeight && physDataArray[i].y <= physConsts.canyonSize) { // hit
-                    clearPhysicsData(&localDataArray[i]);
-                    gameData.foundationDamage++;
-                    if (gameData.foundationDamage >= physConsts.castleConst.foundationHitsRequired) {
-                        gameData.state = win;
-                    }
-                } else if (localDataArray[i].y <= 0) { // Destroy on ground
-                    clearPhysicsData(&localDataArray[i]);
-                } else if (localDataArray[i].x <= 0  && localDataArray[i].y < physConsts.castleConst.castleHeight){ // Destroy of below castle
-                    clearPhysicsData(&localDataArray[i]);
-                }
-            } else if (localDataArray[i].objectType == satchel) { // satchel physics
-                localDataArray[i].xAcc = 0;
-                localDataArray[i].yAcc = gravity;
-                localDataArray[i].yVel += localDataArray[i].yAcc * ((float)physConsts.physicsPeriod / 1000);
-                localDataArray[i].x += localDataArray[i].xVel * ((float)physConsts.physicsPeriod / 1000);
-                localDataArray[i].y += localDataArray[i].yVel * ((float)physConsts.physicsPeriod / 1000);
-                if ((localDataArray[i].y + physConsts.satchelConst.satchelDisplayDiameter / 2) <= 0 && localDataArray[i].x > localDataArray[0].x - physConsts.platformConst.platformLength / 2 && localDataArray[i].x < localDataArray[0].x + physConsts.platformConst.platformLength / 2) { // Lose on hit
-                    clearPhysicsData(&localDataArray[i]);
-                    gameData.state = fail;
-                } else if ((localDataArray[i].y + physConsts.satchelConst.satchelDisplayDiameter / 2) < 0) { // Destroy on ground
-                    clearPhysicsData(&localDataArray[i]);
-                } else if ((localDataArray[i].x + physConsts.satchelConst.satchelDisplayDiameter / 2) > physConsts.canyonSize){ // bounce off wall if hit
-                    localDataArray[i].xVel = -localDataArray[i].xVel;
-                    localDataArray[i].x = physConsts.canyonSize - (int)localDataArray[i].x % physConsts.canyonSize;
-                }
-            } else if (localDataArray[i].objectType == player) { // player physics
-                localDataArray[i].xAcc = localDataArray[i].xForce / localDataArray[i].mass; // F = ma
-                localDataArray[i].xVel += localDataArray[i].xAcc * ((float)physConsts.physicsPeriod / 1000);
-                if (localDataArray[i].xVel > physConsts.platformConst.maxPlatformSpeed) {
-                    localDataArray[i].xVel = physConsts.platformConst.maxPlatformSpeed;
-                } else if (localDataArray[i].xVel < -physConsts.platformConst.maxPlatformSpeed) {
-                    localDataArray[i].xVel = -physConsts.platformConst.maxPlatformSpeed;
-                }
-                localDataArray[i].x += localDataArray[i].xVel * ((float)physConsts.physicsPeriod / 1000);
-                localDataArray[i].xForce = 0; // Forces aren't constant, so they need to be reset
-                // Check if player hit wall, if so bounce
-                if (localDataArray[i].x + physConsts.platformConst.platformLength / 2 < 0) {
-                    localDataArray[i].xVel = -localDataArray[i].xVel;
-                    localDataArray[i].x = localDataArray[i].x + 2*((int)(localDataArray[i].x + physConsts.platformConst.platformLength) % physConsts.canyonSize);
-                } else if (localDataArray[i].x + physConsts.platformConst.platformLength / 2 > physConsts.canyonSize) {
-                    localDataArray[i].xVel = -localDataArray[i].xVel;
-                    localDataArray[i].x = localDataArray[i].x - 2*((int)(localDataArray[i].x + physConsts.platformConst.platformLength) % physConsts.canyonSize);
-                } 
-            }
+        // Wait for the next fixed step. When behind, run up to PHYSICS_MAX_CATCH_UP steps back to back
+        while (pendingSteps == 0) {
+            OSTimeDly(stepTicksUntilDue(&physicsTimestep, OSTimeGet(&err)), OS_OPT_TIME_DLY, &err);
+            while (err.Code != RTOS_ERR_NONE) {}
+            pendingSteps = stepAdvance(&physicsTimestep, OSTimeGet(&err));
+            physicsCountWakeup(OSTimeGet(&err), 0);
         }
-        OSMutexPend(&physicsStructMutex, 0, OS_OPT_PEND_BLOCKING, DEF_NULL, &err);
-        while (err.Code != RTOS_ERR_NONE) {}
-        // Copy local data to global data
-        for (int i = 0; i < 10; i++) {
-            physDataArray[i].mass= localDataArray[i].mass;
-            physDataArray[i].x = localDataArray[i].x;
-            physDataArray[i].y = localDataArray[i].y;
-            physDataArray[i].xVel = localDataArray[i].xVel;
-            physDataArray[i].yVel = localDataArray[i].yVel;
-            physDataArray[i].xAcc = localDataArray[i].xAcc;
-            physDataArray[i].yAcc = localDataArray[i].yAcc;
-            physDataArray[i].xForce = localDataArray[i].xForce;
-            physDataArray[i].yForce = localDataArray[i].yForce;
-            physDataArray[i].objectType = localDataArray[i].objectType;
+        pendingSteps--;
+        OSSemSet(&physicsSem, 0, &err); // Changes from here on are newer than the inputs read below
+        CYCLE_BEGIN(mark);
+        if (!replaying || !replayNext(replay, &inputs)) {
+            readInputs(&inputs);
         }
-        OSMutexPost(&physicsStructMutex, OS_OPT_POST_NONE, &err);
-        while (err.Code != RTOS_ERR_NONE) {}
+        recorderTick(&inputRecorder, &inputs);
+        CYCLE_LAP(phaseInputs, mark);
+        uint32_t stepStart = lcdSpiClock(NULL);
+        physicsStep(&physicsState, &inputs, dt);
+        physicsStepTime.cycles += lcdSpiClock(NULL) - stepStart;
+        physicsStepTime.steps++;
+        CYCLE_END(phaseStep, mark);
+        quietSteps = replaying ? 0 : gameQuietSteps(&physicsState, &inputs);
+        if (pendingSteps == 0 || physicsState.game.state != active) {
+            // Publish once per batch of steps for the display and LED tasks
+            CYCLE_BEGIN(publishMark);
+            gamePrepareFrame(&physicsState);
+            snapshotPublish(&physicsSnapshot, physicsState.objects, physicsState.previous, &physicsState.game,
+                            physicsTimestep.stateTime, physicsTimestep.stepTicks);
+            CYCLE_END(phasePublish, publishMark);
+            CYCLE_SERVICE(cycleReportLine);
+            pendingSteps = 0;
+        }
+    }
+    recorderFinish(&inputRecorder, &physicsState.game);
+    if (replaying) {
+        struct gameData recorded;
+        replayResult = replayOutcome(replay, &recorded) && replaySameOutcome(&recorded, &physicsState.game) ? 1 : -1;
+    }
+    gameStateBroadcast(physicsState.game.state);
+}
+/***************************************************************************//**
+ * @brief
+ *   Physics task. Menu, game, game over screen, and around again. A restart
+ *   reinitializes the game in place; no task is recreated.
+ ******************************************************************************/
+void  physicsTask (void  *p_arg)
+{
+    /* Use argument. */
+   (void)&p_arg;
+   RTOS_ERR     err;
+    static struct physicsConstants replayConsts;
+    struct replay replay;
+    uint32_t seed = GAME_DEFAULT_SEED;
+    int profile = PHYSICS_DEFAULT_PROFILE;
+    recorderInit(&inputRecorder);
+
+   while (DEF_TRUE) {
+        profile = physicsMenu(profile);
+        // A record waiting in replayBuffer is played by this game, and by this game only
+        uint32_t length = replayLength;
+        replayLength = 0;
+        bool replaying = length && replayOpen(&replay, replayBuffer, length, &seed, &replayConsts);
+        CYCLE_BEGIN(restartMark);
+        if (replaying) {
+            physConsts = &replayConsts; // Play with the constants it was recorded with
+            gameInit(&physicsState, physConsts, seed);
+        } else {
+            seed = OSTimeGet(&err); // Each game its own satchels; the record keeps the seed
+            physConsts = &physicsProfiles[profile].consts;
+            railgunSetAngle(angleFromDegrees(physConsts->railGunConst.railgunAngle));
+            gameInitProfile(&physicsState, profile, seed);
+        }
+        CYCLE_END(phaseRestart, restartMark);
+        evacComplete = false;
+        recorderBegin(&inputRecorder, seed, physConsts);
+        physicsPlay(&replay, replaying);
+        physicsWaitRestart();
    }
-   if (err.Code) {}
 }
 
 static GLIB_Context_t glibContext;
+// Update commands go out on LDMA from two command buffers, so a frame's lines are queued while
+// the last frame is still being sent. The display task pends on lcdFlushSem only when both are
+// busy. lcdFlush.stats counts transfers, bytes and waits, the latency from the start of a frame
+// to the end of its transfer (in cycles) and frames per second; set lcdFreeRun from the
+// debugger to draw frames back to back and read the maximum rate there.
+OS_SEM lcdFlushSem;
+struct lcdFlush lcdFlush;
+volatile bool lcdFreeRun;
+// Frames the display task woke for, and those of them it skipped because their scene hash
+// matched the frame on the panel. Skipped frames are neither composed nor sent.
+struct lcdSceneStats {
+    uint32_t frames;
+    uint32_t skipped;
+} lcdSceneStats;
+// The game screen's frame interval follows the action, from LCD_PERIOD_MIN with the field full
+// of fast objects to the profile's lcdPeriod with nothing moving. lcdRate.stats holds the chosen
+// period and rate and the time each composed frame took; lcdRate.config can be tuned live.
+#ifndef LCD_PERIOD_MIN
+#define LCD_PERIOD_MIN 30 // ms
+#endif
+struct frameRate lcdRate;
+// Performance HUD over the screen, toggled by pressing both buttons at once or by setting
+// perfHudVisible from the debugger. While it is shown the display task samples the task
+// statistics into perfHud every PERF_HUD_PERIOD and wakes at least that often; the renderer
+// rasterizes the HUD once per sample and copies it over every frame.
+#define PERF_HUD_PERIOD 500 // ms
+volatile bool perfHudVisible;
+struct perfHudSample perfHud;
+static uint32_t perfHudVersion = 1;
+static void perfHudCollect(struct perfHudSample *sample);
+static void lcdFlushPend(void *ctx)
+{
+    RTOS_ERR err;
+    OSSemPend(ctx, 0, OS_OPT_PEND_BLOCKING, DEF_NULL, &err);
+    while (err.Code != RTOS_ERR_NONE) {}
+}
+// Called from the transfer done interrupt
+static void lcdFlushPost(void *ctx)
+{
+    RTOS_ERR err;
+    OSSemPost(ctx, OS_OPT_POST_1, &err);
+}
+// What the panel shows, so a frame only sends the lines that changed. lcdLines.stats counts
+// frames and lines sent; read it with the debugger.
+struct lcdLines lcdLines;
+static uint8_t lcdCommand[LCD_FLUSH_QUEUE][LCD_UPDATE_MAX_BYTES];
+static uint32_t lcdCommandTicket[LCD_FLUSH_QUEUE]; // lcdFlushStart() ticket of each buffer's last command
+static unsigned lcdCommandNext;
+static void *lcdFramebuffer; // The DMD framebuffer GLIB draws into
+// Everything the display draws, with its cached background and sprites
+#ifndef LCD_STATIC_LAYER
+#define LCD_STATIC_LAYER 1 // 0 redraws the game screen's background every frame, to compare phaseCompose
+#endif
+static struct renderer lcdRenderer;
+// Bumped by LCD_invalidateCannon(); the renderer rebuilds the barrel when it no longer matches
+static volatile uint32_t cannonAimVersion = 1;
 
 static void LCD_init()
 {
@@ -696,6 +526,48 @@ static void LCD_init()
   GLIB_setFont(&glibContext, (GLIB_Font_t *) &GLIB_FontNormal8x8);
 
   DMD_updateDisplay();
+  lcdLinesInit(&lcdLines);
+  struct lcdTransport transport = {
+      .start = lcdSpiStart,
+      .wait = lcdFlushPend,
+      .wake = lcdFlushPost,
+      .clock = lcdSpiClock,
+      .clockHz = SystemCoreClockGet(),
+      .ctx = &lcdFlushSem,
+  };
+  lcdSpiInit(&lcdFlush);
+  lcdFlushInit(&lcdFlush, &transport);
+  const struct frameRateConfig rateConfig = {
+      .minPeriod = LCD_PERIOD_MIN,
+      .maxPeriod = physicsProfiles[PHYSICS_DEFAULT_PROFILE].consts.lcdPeriod, // Until the menu picks a profile
+      .motionPixels = 2,
+      .busyObjects = 4,
+  };
+  frameRateInit(&lcdRate, &rateConfig);
+  status = DMD_getFrameBuffer(&lcdFramebuffer);
+  EFM_ASSERT(status == DMD_OK);
+  renderInit(&lcdRenderer, &glibContext, lcdFramebuffer, LCD_STATIC_LAYER);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Replaces DMD_updateDisplay(): sends only the framebuffer lines that
+ *   changed since the last flush, all in one transfer. Returns once the
+ *   transfer is queued. The lines are copied into a command buffer, so the
+ *   next frame can be drawn while they are sent. frameStart is the
+ *   lcdFlushClock() time the frame began, for the latency stats.
+ ******************************************************************************/
+static void LCD_flush(uint32_t frameStart)
+{
+    CYCLE_BEGIN(flushMark);
+    uint8_t *command = lcdCommand[lcdCommandNext];
+    lcdFlushWaitFor(&lcdFlush, lcdCommandTicket[lcdCommandNext]); // Sent two frames ago, normally long done
+    size_t length = lcdLinesUpdate(&lcdLines, lcdFramebuffer, command);
+    if (length > 0) {
+        lcdCommandTicket[lcdCommandNext] = lcdFlushStart(&lcdFlush, command, length, frameStart);
+        lcdCommandNext = (lcdCommandNext + 1) % LCD_FLUSH_QUEUE;
+    }
+    CYCLE_END(phaseFlush, flushMark);
 }
 
 #define  LCD_DISPLAY_PRIO            21u  /*   Task Priority.                 */
@@ -728,6 +600,14 @@ void  LCDTaskCreate (void)
         /* Handle error on task creation. */
     }
 }
+/***************************************************************************//**
+ * @brief
+ *   Marks the cached barrel stale. Safe to call from any task.
+ ******************************************************************************/
+void LCD_invalidateCannon(void)
+{
+    cannonAimVersion++;
+}
 /***************************************************************************//**
  * @brief
  *   Task that displays the game on the LCD. 
@@ -737,191 +617,77 @@ void  LCDDisplayTask (void  *p_arg)
     /* Use argument. */
    (void)&p_arg;
    RTOS_ERR     err;
-   struct __GLIB_Rectangle_t rectangles[7];
-   struct __GLIB_Rectangle_t battery[6];
-   struct __GLIB_Rectangle_t platform;
-   int cannonLength = physConsts.platformConst.platformLength;
+   static struct gameFrame frame; // Too large for this task's stack
+   struct physicsData *objects = frame.objects;
+   bool shownValid = false; // shownHash is that of the frame on the panel
+   uint32_t shownHash = 0;
+   bool staticScreen = false; // The panel shows a screen that only a state change alters
+   const struct physicsConstants *rateConsts = NULL; // Profile lcdRate's upper bound is from
+   bool hudShown = false; // perfHudVisible as of the last frame
+   uint32_t hudSampled = 0; // OS tick of the latest HUD sample
+   const uint32_t hudTicks = (PERF_HUD_PERIOD * OSTimeTickRateHzGet(&err) + 999) / 1000;
     while (DEF_TRUE) {
-        OSTimeDlyHMSM(0, 0, 0, physConsts.lcdPeriod, OS_OPT_TIME_DLY, &err);
-        while (err.Code != RTOS_ERR_NONE) {}
-        if (gameData.state == active) {
-            GLIB_clear(&glibContext);
-            // Generate cliff
-            GLIB_drawLineV(&glibContext, 0, screenSize - physConsts.castleConst.castleHeight - physConsts.castleConst.foundationDepth, screenSize);
-            GLIB_drawLineV(&glibContext, 1, screenSize - physConsts.castleConst.castleHeight - physConsts.castleConst.foundationDepth, screenSize);
-            // Generate right wall
-            GLIB_drawLineV(&glibContext, screenSize, 0, screenSize);
-            GLIB_drawLineV(&glibContext, screenSize - 1, 0, screenSize - 1);
-            // Generate castle
-            // Left wall
-             rectangles[0].xMin = 0;
-             rectangles[0].xMax = physConsts.castleConst.foundationHitsRequired * 2;
-             rectangles[0].yMin = 0;
-             rectangles[0].yMax = screenSize - physConsts.castleConst.castleHeight;
-            // Ceiling
-             rectangles[1].xMin = 0;
-             rectangles[1].xMax = 20;
-             rectangles[1].yMin = 0;
-             rectangles[1].yMax = 5;
-            // Right wall
-             rectangles[2].xMin = 15;
-             rectangles[2].xMax = 20;
-             rectangles[2].yMin = 0;
-             rectangles[2].yMax = screenSize - physConsts.castleConst.castleHeight;
-            // Floor
-             rectangles[3].xMin = 0;
-             rectangles[3].xMax = 20;
-             rectangles[3].yMin = screenSize - physConsts.castleConst.castleHeight - 5;
-             rectangles[3].yMax = screenSize - physConsts.castleConst.castleHeight;
-            // Flag pole
-             rectangles[4].xMin = 20;
-             rectangles[4].xMax = 35;
-             rectangles[4].yMin = 0;
-             rectangles[4].yMax = 2;
-            // Flag
-             rectangles[5].xMin = 25;
-             rectangles[5].xMax = 35;
-             rectangles[5].yMin = 0;
-             rectangles[5].yMax = screenSize - physConsts.castleConst.castleHeight - 10;
-            // Generate Foundation
-             rectangles[6].xMin = 0;
-             rectangles[6].xMax = (physConsts.castleConst.foundationHitsRequired - gameData.foundationDamage) * 2;
-             rectangles[6].yMin = screenSize - physConsts.castleConst.castleHeight;
-             rectangles[6].yMax = screenSize - physConsts.castleConst.castleHeight + physConsts.castleConst.foundationDepth;
-            // Draw castle
-            for (int i = 0; i < 7; i++) {
-                GLIB_drawRectFilled(&glibContext, &rectangles[i]);
-            }
-            // Generate platform
-              platform.xMin = physDataArray[0].x - physConsts.platformConst.platformLength / 2;
-              platform.xMax = physDataArray[0].x + physConsts.platformConst.platformLength / 2;
-              platform.yMin = screenSize - 4;
-              platform.yMax = screenSize;
-            GLIB_drawRectFilled(&glibContext, &platform);
-            // Draw Cannon 3 pixels thick
-            for (int i = -1; i < 3; i++) {
-                GLIB_drawLine(&glibContext, physDataArray[0].x + (int32_t)cannonLength * cos(physConsts.railGunConst.railgunAngle * 3.14159 / 180) + i, screenSize - 4 + (int32_t)(cannonLength * sin(physConsts.railGunConst.railgunAngle * 3.14159 / 180)), physDataArray[0].x + i, screenSize - 4);
-            }
-            // Draw Projectiles
-            for (int i = 0; i < 10; i++) {
-                if (physDataArray[i].objectType == satchel) {
-                    GLIB_drawCircleFilled(&glibContext, physDataArray[i].x, screenSize - physDataArray[i].y, physConsts.satchelConst.satchelDisplayDiameter / 2);
-                } else if (physDataArray[i].objectType == shot) {
-                    GLIB_drawCircleFilled(&glibContext, physDataArray[i].x, screenSize - physDataArray[i].y, physConsts.railGunConst.shotRadius);
-                }
+        // Redraw at the rate lcdRate picked, or at once when the game state changes. Menus and end
+        // screens wait for the change alone, or for the next HUD sample while the HUD is shown.
+        OSSemPend(&LCDSem, lcdFreeRun ? 1 : staticScreen ? (perfHudVisible ? hudTicks : 0)
+                  : (lcdRate.stats.period * OSTimeTickRateHzGet(&err) + 999) / 1000,
+                  OS_OPT_PEND_BLOCKING, DEF_NULL, &err);
+        while (err.Code != RTOS_ERR_NONE && err.Code != RTOS_ERR_TIMEOUT) {}
+        uint32_t frameStart = lcdFlushClock(&lcdFlush);
+        snapshotRead(&physicsSnapshot, &frame);
+        // Draw one step behind physics, blending the last two steps by how far into the step we are
+        uint32_t now = OSTimeGet(&err);
+        snapshotInterpolate(&frame, stepAlpha(frame.stateTime, frame.stepTicks, now));
+        uint32_t behind = now - frame.stateTime;
+        if (frame.game.state == active && behind > frame.stepTicks) {
+            // Physics is idle and publishes nothing new, but satchels are still flying on their paths
+            fix16_t seconds = fix16FromFrac((int32_t)(behind - frame.stepTicks) * physConsts->physicsPeriod,
+                                            (int32_t)frame.stepTicks * 1000);
+            snapshotExtrapolate(&frame, seconds, FIX16_FROM_INT(GRAVITY));
+        }
+        if (rateConsts != physConsts) {
+            lcdRate.config.maxPeriod = physConsts->lcdPeriod;
+            rateConsts = physConsts;
+        }
+        uint32_t inFlight = 0;
+        fix16_t maxSpeed = 0;
+        for (int i = 0; i < PHYSICS_MAX_OBJECTS; i++) {
+            if (objects[i].objectType == satchel || objects[i].objectType == shot) {
+                inFlight++;
             }
-            // Draw Battery
-            // Remaining battery
-             battery[0].xMin = screenSize - 13;
-             battery[0].xMax = screenSize - 8;
-             battery[0].yMin = 31 - (gameData.energy / physConsts.generatorConst.energyCapacity * 20);
-             battery[0].yMax = 32;
-             // Left Battery wall
-             battery[1].xMin = screenSize - 16;
-             battery[1].xMax = screenSize - 15;
-             battery[1].yMin = 10;
-             battery[1].yMax = 35;
-            // Top Battery
-             battery[2].xMin = screenSize - 16;
-             battery[2].xMax = screenSize - 5;
-             battery[2].yMin = 10;
-             battery[2].yMax = 11;
-            // Right Battery wall
-            battery[3].xMin = screenSize - 6;
-            battery[3].xMax = screenSize - 5;
-            battery[3].yMin = 10;
-            battery[3].yMax = 35;
-            // Bottom Battery
-            battery[4].xMin = screenSize - 16;
-            battery[4].xMax = screenSize - 5;
-            battery[4].yMin = 34;
-            battery[4].yMax = 35;
-            // Battery bump
-             battery[5].xMin = screenSize - 13;
-             battery[5].xMax = screenSize - 8;
-             battery[5].yMin = 5;
-             battery[5].yMax = 10;
-             for (int i = 0; i < 6; i++) {
-                GLIB_drawRectFilled(&glibContext, &battery[i]);
-             }
-             if (gameData.shieldActive) { // Draw shield
-                GLIB_drawCircle(&glibContext, physDataArray[0].x, screenSize - 4, physConsts.shieldConst.shieldEffectiveRange);
-                gameData.shieldActive = false;
-             }
-             DMD_updateDisplay();
-        } else if (gameData.state == fail) {
-            GLIB_clear(&glibContext);
-            GLIB_drawStringOnLine(&glibContext,
-                                    "Game Over",
-                                    0,
-                                    GLIB_ALIGN_LEFT,
-                                    5,
-                                    5,
-                                    true);
-            GLIB_drawStringOnLine(&glibContext,
-                                    "You Lost",
-                                    2,
-                                    GLIB_ALIGN_LEFT,
-                                    5,
-                                    15,
-                                    true);
-             DMD_updateDisplay();
-        } else if (gameData.state == win) {
-            GLIB_clear(&glibContext);
-            GLIB_drawStringOnLine(&glibContext,
-                        "Game Over",
-                        0,
-                        GLIB_ALIGN_LEFT,
-                        5,
-                        5,
-                        true);
-            if (!gameData.evacComplete) {
-                GLIB_drawStringOnLine(&glibContext,
-                                        "You Lost",
-                                        2,
-                                        GLIB_ALIGN_LEFT,
-                                        5,
-                                        15,
-                                        true);
-                GLIB_drawStringOnLine(&glibContext,
-                                        "The prisoners",
-                                        4,
-                                        GLIB_ALIGN_LEFT,
-                                        5,
-                                        25,
-                                        true);
-                GLIB_drawStringOnLine(&glibContext,
-                                        "failed to evac",
-                                        5,
-                                        GLIB_ALIGN_LEFT,
-                                        5,
-                                        30,
-                                        true);
-            } else {
-                GLIB_drawStringOnLine(&glibContext,
-                                        "You Won",
-                                        2,
-                                        GLIB_ALIGN_LEFT,
-                                        5,
-                                        15,
-                                        true);
-                GLIB_drawStringOnLine(&glibContext,
-                                        "The prisoners",
-                                        4,
-                                        GLIB_ALIGN_LEFT,
-                                        5,
-                                        25,
-                                        true);
-                GLIB_drawStringOnLine(&glibContext,
-                                        "have escaped",
-                                        5,
-                                        GLIB_ALIGN_LEFT,
-                                        5,
-                                        30,
-                                        true);
+            if (objects[i].objectType != empty) {
+                fix16_t speed = fix16Abs(objects[i].xVel) > fix16Abs(objects[i].yVel) ? fix16Abs(objects[i].xVel) : fix16Abs(objects[i].yVel);
+                maxSpeed = speed > maxSpeed ? speed : maxSpeed;
             }
-             DMD_updateDisplay();
         }
+        frameRatePick(&lcdRate, inFlight, maxSpeed);
+        bool hudVisible = perfHudVisible;
+        if (hudVisible && (!hudShown || now - hudSampled >= hudTicks)) {
+            perfHudCollect(&perfHud);
+            perfHudVersion++;
+            hudSampled = now;
+        }
+        hudShown = hudVisible;
+        // Nothing to compose or send when the frame would come out as the one shown
+        struct renderScene scene = {.frame = &frame, .consts = physConsts, .aimVersion = cannonAimVersion,
+                                    .hud = hudVisible ? &perfHud : NULL, .hudVersion = perfHudVersion};
+        scene.aim = railgunAim; // Read after the version, so a change in between is caught next frame
+        uint32_t hash = renderHash(&lcdRenderer, &scene);
+        lcdSceneStats.frames++;
+        staticScreen = frame.game.state != active;
+        if (shownValid && hash == shownHash) {
+            lcdSceneStats.skipped++;
+            continue;
+        }
+        shownHash = hash;
+        shownValid = true;
+        CYCLE_BEGIN(composeMark);
+        renderDraw(&lcdRenderer, &scene);
+        if (frame.game.state == active) {
+            CYCLE_END(phaseCompose, composeMark);
+        }
+        LCD_flush(frameStart);
+        frameRateRecord(&lcdRate, lcdFlushMicros(&lcdFlush, lcdFlushClock(&lcdFlush) - frameStart));
     }
 }
 
@@ -964,14 +730,21 @@ void LED0Task (void  *p_arg)
     (void)&p_arg;
     RTOS_ERR err;
     static int counter;
+    struct gameData game;
     while (DEF_TRUE) {
+        gameStateWait(active); // Sleeps through the menu and game over screens
         OSTimeDlyHMSM(0, 0, 0, 50, OS_OPT_TIME_DLY, &err);
         while (err.Code != RTOS_ERR_NONE) {}
         counter++;
-        if (gameData.shotCharge == 0) {
+        snapshotReadGame(&physicsSnapshot, &game);
+        if (game.state != active) {
+            GPIO_PinOutClear(LED0_port, LED0_pin);
+            continue;
+        }
+        if (game.shotCharge == 0) {
             continue;
         }
-        if (!(counter % (10 - (int)(10 *(gameData.shotCharge / physConsts.generatorConst.maxShotPower))))) {
+        if (!(counter % (10 - (int)(10 * game.shotCharge / (physConsts->generatorConst.maxShotPower * JOULES_PER_KJ))))) {
             GPIO_PinOutSet(LED0_port, LED0_pin);
         } else {
             GPIO_PinOutClear(LED0_port, LED0_pin);
@@ -1020,17 +793,24 @@ void LED1Task (void  *p_arg)
     RTOS_ERR err;
     int counter = 0;
     bool LEDState = false;
-    gameData.evacComplete = 0;
+    struct gameData game;
+    // evacComplete reaches the published gameData through the physics inputs
+    evacComplete = 0;
+    snapshotReadGame(&physicsSnapshot, &game);
     while (DEF_TRUE) {
-        while (gameData.state != active) {// stop when game not running. Used to block task
-            OSSemPend(&gameEndSem, 0, OS_OPT_PEND_BLOCKING, DEF_NULL, &err);
-            while (err.Code != RTOS_ERR_NONE) {}
+        if (game.state != active) {
+            // Ready for the next game: the physics task clears evacComplete when it restarts
+            counter = 0;
+            LEDState = false;
+            GPIO_PinOutClear(LED1_port, LED1_pin);
+            gameStateWait(active);
         }
         OSTimeDlyHMSM(0, 0, 0, 50, OS_OPT_TIME_DLY, &err);
-        if (gameData.foundationDamage >= physConsts.castleConst.foundationHitsRequired * .5) {
+        snapshotReadGame(&physicsSnapshot, &game);
+        if (game.state == active && game.foundationDamage >= physConsts->castleConst.foundationHitsRequired * .5) {
             counter++;
             // Turn led on and off with 1 second period 50% duty cycle
-            if (counter % 10 && gameData.evacComplete == 0) {
+            if (counter % 10 && evacComplete == 0) {
                 if (LEDState) {
                     GPIO_PinOutClear(LED1_port, LED1_pin);
                     LEDState = false;
@@ -1042,7 +822,8 @@ void LED1Task (void  *p_arg)
                 GPIO_PinOutSet(LED1_port, LED1_pin);
             }
             if (counter == evacTime * 20) {
-                gameData.evacComplete = 1;
+                evacComplete = 1;
+                OSSemPost(&physicsSem, OS_OPT_POST_1, &err); // An input for the next step
             }
             
         }
@@ -1101,6 +882,7 @@ void  buttonTask (void  *p_arg)
     /* Use argument. */
    (void)&p_arg;
    RTOS_ERR     err;
+   bool bothPressed = false;
 
    while (DEF_TRUE) {
        OSSemPend(&buttonSem, 0, OS_OPT_PEND_BLOCKING, NULL, &err);
@@ -1127,6 +909,16 @@ void  buttonTask (void  *p_arg)
        }
        OSMutexPost(&buttonStructMutex, OS_OPT_POST_NONE, &err);
        while (err.Code != RTOS_ERR_NONE) {}
+       OSSemPost(&physicsSem, OS_OPT_POST_1, &err); // Wake the physics task if it is idle
+       while (err.Code != RTOS_ERR_NONE) {}
+       // Both buttons at once, which the game reads as neither, toggle the performance HUD
+       bool both = GPIO_PinInGet(BUTTON1_port, BUTTON1_pin) && GPIO_PinInGet(BUTTON0_port, BUTTON0_pin);
+       if (both && !bothPressed) {
+           perfHudVisible = !perfHudVisible;
+           OSSemPost(&LCDSem, OS_OPT_POST_1, &err); // Menus and end screens only redraw when woken
+           while (err.Code != RTOS_ERR_NONE) {}
+       }
+       bothPressed = both;
 #endif
 #ifdef TEST_MODE
     //    if (GPIO_PinInGet(BUTTON1_port, BUTTON1_pin)) {
@@ -1186,9 +978,10 @@ void  sliderTask (void  *p_arg)
    // Initialize slider state struct
     while (DEF_TRUE) {
 #ifndef TEST_MODE
-        OSTimeDlyHMSM(0, 0, 0, physConsts.sliderPeriod, OS_OPT_TIME_DLY, &err);
+        OSTimeDlyHMSM(0, 0, 0, physConsts->sliderPeriod, OS_OPT_TIME_DLY, &err);
         while (err.Code != RTOS_ERR_NONE) {}
         OSMutexPend(&sliderMutex, OS_OPT_PEND_BLOCKING, 0, NULL, &err);
+        struct sliderState before = sliderState;
         CAPSENSE_Sense();
         // Map the capacitive touch sensor readings to the direction struct
         if (CAPSENSE_getPressed(0)) {
@@ -1212,9 +1005,12 @@ void  sliderTask (void  *p_arg)
             sliderState.farRight = 0;
         }
         OSMutexPost(&sliderMutex, OS_OPT_POST_NONE, &err);
+        if (memcmp(&before, &sliderState, sizeof(before)) != 0) {
+            OSSemPost(&physicsSem, OS_OPT_POST_1, &err); // Wake the physics task if it is idle
+        }
 #endif
 #ifdef TEST_MODE
-        OSTimeDlyHMSM(0, 0, 0, physConsts.sliderPeriod, OS_OPT_TIME_DLY, &err);
+        OSTimeDlyHMSM(0, 0, 0, physConsts->sliderPeriod, OS_OPT_TIME_DLY, &err);
         while (err.Code != RTOS_ERR_NONE) {}
         CAPSENSE_Sense();
         if (CAPSENSE_getPressed(0) || CAPSENSE_getPressed(1)) {
@@ -1280,6 +1076,46 @@ void  idleTask (void  *p_arg)
    }
 }
 
+/***************************************************************************//**
+ * @brief
+ *   Fills a HUD sample. Per task CPU usage and stack headroom are those the
+ *   statistics task keeps in each TCB (OS_CFG_TASK_PROFILE_EN and
+ *   OS_CFG_STAT_TASK_STK_CHK_EN). The total is what the idle task leaves:
+ *   it never blocks, so the kernel's own idle task, which OSStatTaskCPUUsage
+ *   is derived from, never runs. Called from the display task only.
+ ******************************************************************************/
+static void perfHudCollect(struct perfHudSample *sample)
+{
+    static const struct {
+        const char *name;
+        OS_TCB *tcb;
+    } tasks[PERF_HUD_TASKS] = {
+        {"phys", &physicsTaskTCB},
+        {"lcd", &LCDDisplayTaskTCB},
+        {"btn", &buttonTaskTCB},
+        {"sldr", &sliderTaskTCB},
+        {"led0", &LED0TaskTCB},
+        {"led1", &LED1TaskTCB},
+    };
+    static struct physicsStepTime last;
+    uint32_t steps = physicsStepTime.steps;
+    uint32_t cycles = physicsStepTime.cycles;
+    if (steps != last.steps) { // Otherwise physics is idle; keep the last mean
+        sample->stepMicros = lcdFlushMicros(&lcdFlush, (cycles - last.cycles) / (steps - last.steps));
+    }
+    last.steps = steps;
+    last.cycles = cycles;
+    sample->cpu = idleTaskTCB.CPUUsage < 10000u ? 10000u - idleTaskTCB.CPUUsage : 0;
+    sample->rate = lcdRate.stats.rate;
+    sample->frameMicros = lcdRate.stats.frameMicros;
+    sample->tasks = PERF_HUD_TASKS;
+    for (int i = 0; i < PERF_HUD_TASKS; i++) {
+        sample->task[i].name = tasks[i].name;
+        sample->task[i].cpu = tasks[i].tcb->CPUUsage;
+        sample->task[i].stackFree = tasks[i].tcb->StkFree;
+    }
+}
+
 /***************************************************************************//**
  * @brief
  *   Main function.
@@ -1293,29 +1129,35 @@ void app_init(void)
   // Initialize our capactive touch sensor driver!
   CAPSENSE_Init();
 
+  CYCLE_INIT(); // Zeroes the cycle counter the LCD flush stats also run on
+
   // Initialize our LCD system
   LCD_init();
   // Initialize Physical constants
-  physConsts = physicsConstantsInit();
+  physConsts = &physicsProfiles[PHYSICS_DEFAULT_PROFILE].consts; // Until the menu picks one
+  railgunSetAngle(angleFromDegrees(physConsts->railGunConst.railgunAngle));
+  snapshotInit(&physicsSnapshot);
 
   // Mutex Creation
   OSMutexCreate(&buttonStructMutex, "button mutex", &err);
   while (err.Code != RTOS_ERR_NONE) {}
   OSMutexCreate(&sliderMutex, "Slider Mutex", &err);
   while (err.Code != RTOS_ERR_NONE) {}
-  OSMutexCreate(&physicsStructMutex, "Physics Mutex", &err);
-  while (err.Code != RTOS_ERR_NONE) {}
 
   // Semaphore Creation
   OSSemCreate(&buttonSem, "Button Semaphore", 0, &err);
   while (err.Code != RTOS_ERR_NONE) {}
   OSSemCreate(&sliderSem, "Slider Semaphore", 0, &err);
   while (err.Code != RTOS_ERR_NONE) {}
-  OSSemCreate(&physicsSem, "LED0 Semaphore", 0, &err);
+  OSSemCreate(&physicsSem, "Physics Wake Semaphore", 0, &err);
   while (err.Code != RTOS_ERR_NONE) {}
   OSSemCreate(&LCDSem, "LCD Semaphore", 0, &err);
   while (err.Code != RTOS_ERR_NONE) {}
-  OSSemCreate(&gameEndSem, "Game End Semaphore", 0, &err);
+  OSSemCreate(&lcdFlushSem, "LCD Flush Semaphore", 0, &err);
+  while (err.Code != RTOS_ERR_NONE) {}
+
+  // Event Flag Creation
+  OSFlagCreate(&gameStateFlags, "Game State Flags", GAME_STATE_FLAG(menu), &err);
   while (err.Code != RTOS_ERR_NONE) {}
 
   // Task Creation
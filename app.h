@@ -18,6 +18,8 @@
 #ifndef APP_H
 #define APP_H
 #include <stdbool.h>
+#include <stdint.h>
+#include "angle.h"
 
 /***************************************************************************//**
  * Structs
@@ -32,4 +34,22 @@
 void app_init(void);
 void GPIO_INTERRUPT_Handler(void);
 
+/***************************************************************************//**
+ * Railgun aim, in binary angle units (see angle.h).
+ ******************************************************************************/
+void railgunSetAngle(angle_t angle);
+angle_t railgunGetAngle(void);
+
+/***************************************************************************//**
+ * Tells the display the railgun aim changed, so it re-rasterizes the barrel.
+ * railgunSetAngle() calls it; anything else that moves the barrel must too.
+ ******************************************************************************/
+void LCD_invalidateCannon(void);
+
+/***************************************************************************//**
+ * Input recorder (see recorder.h). Copies a finished game's record into the
+ * replay buffer and returns its length, 0 being the latest game.
+ ******************************************************************************/
+uint32_t physicsExportRecording(unsigned newest);
+
 #endif  // APP_H
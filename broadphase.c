@@ -0,0 +1,103 @@
+/***************************************************************************//**
+ * @file
+ * @brief Uniform grid broadphase for range and overlap queries
+ ******************************************************************************/
+
+#include "broadphase.h"
+
+// Objects outside the canyon are kept in the edge cells, queries clamp the same way
+static int32_t cellCoord(fix16_t v)
+{
+    int32_t c = fix16ToInt(v) >> BROADPHASE_CELL_SHIFT;
+    if (c < 0) {
+        return 0;
+    } else if (c >= BROADPHASE_GRID_DIM) {
+        return BROADPHASE_GRID_DIM - 1;
+    }
+    return c;
+}
+
+static void cellUnlink(struct broadphase *bp, poolIndex_t index)
+{
+    poolIndex_t prev = bp->prev[index];
+    poolIndex_t next = bp->next[index];
+    if (prev != POOL_NONE) {
+        bp->next[prev] = next;
+    } else {
+        bp->cellHead[bp->objects[index].objectType][bp->cell[index]] = next;
+    }
+    if (next != POOL_NONE) {
+        bp->prev[next] = prev;
+    }
+    bp->cell[index] = BROADPHASE_NO_CELL;
+}
+
+void bpInit(struct broadphase *bp, const struct physicsData *objects)
+{
+    bp->objects = objects;
+    for (int type = 0; type < POOL_TYPE_COUNT; type++) {
+        for (int i = 0; i < BROADPHASE_CELLS; i++) {
+            bp->cellHead[type][i] = POOL_NONE;
+        }
+    }
+    for (int i = 0; i < PHYSICS_MAX_OBJECTS; i++) {
+        bp->cell[i] = BROADPHASE_NO_CELL;
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Inserts an object or moves it after its position changed. Does nothing
+ *   when it is still inside the same cell.
+ ******************************************************************************/
+void bpUpdate(struct broadphase *bp, poolIndex_t index)
+{
+    const struct physicsData *obj = &bp->objects[index];
+    uint16_t cell = (uint16_t)(cellCoord(obj->y) * BROADPHASE_GRID_DIM + cellCoord(obj->x));
+    if (bp->cell[index] == cell) {
+        return;
+    }
+    if (bp->cell[index] != BROADPHASE_NO_CELL) {
+        cellUnlink(bp, index);
+    }
+    poolIndex_t *head = &bp->cellHead[obj->objectType][cell];
+    bp->prev[index] = POOL_NONE;
+    bp->next[index] = *head;
+    if (*head != POOL_NONE) {
+        bp->prev[*head] = index;
+    }
+    *head = index;
+    bp->cell[index] = cell;
+}
+
+void bpRemove(struct broadphase *bp, poolIndex_t index)
+{
+    if (bp->cell[index] != BROADPHASE_NO_CELL) {
+        cellUnlink(bp, index);
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns an object of the given type within radius of (x, y), or POOL_NONE.
+ *   Callers that want every match remove the result and ask again.
+ ******************************************************************************/
+poolIndex_t bpFindNearby(const struct broadphase *bp, fix16_t x, fix16_t y, fix16_t radius, uint8_t type)
+{
+    int32_t cx0 = cellCoord(x - radius);
+    int32_t cx1 = cellCoord(x + radius);
+    int32_t cy0 = cellCoord(y - radius);
+    int32_t cy1 = cellCoord(y + radius);
+    for (int32_t cy = cy0; cy <= cy1; cy++) {
+        for (int32_t cx = cx0; cx <= cx1; cx++) {
+            poolIndex_t i = bp->cellHead[type][cy * BROADPHASE_GRID_DIM + cx];
+            for (; i != POOL_NONE; i = bp->next[i]) {
+                const struct physicsData *obj = &bp->objects[i];
+                if (fix16WithinRange(x, y, obj->x, obj->y, radius)) {
+                    return i;
+                }
+            }
+        }
+    }
+    return POOL_NONE;
+}
@@ -0,0 +1,39 @@
+/***************************************************************************//**
+ * @file
+ * @brief Uniform grid broadphase for range and overlap queries
+ *******************************************************************************
+ * The canyon is split into square cells. Each object remembers its cell and is
+ * only relinked when it crosses into another one, so keeping the grid current
+ * costs O(1) per moving object per tick. Queries visit the cells covering the
+ * search circle, walk only the list for the requested type and use
+ * squared-distance tests, never sqrt().
+ ******************************************************************************/
+
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+#include <stdint.h>
+#include "physics.h"
+#include "objpool.h"
+
+#ifndef BROADPHASE_CELL_SHIFT
+#define BROADPHASE_CELL_SHIFT   4 // 16 unit cells, a shield query covers at most 3x3
+#endif
+#define BROADPHASE_WORLD_SIZE   128 // canyon width and height after scaling
+#define BROADPHASE_GRID_DIM     (BROADPHASE_WORLD_SIZE >> BROADPHASE_CELL_SHIFT)
+#define BROADPHASE_CELLS        (BROADPHASE_GRID_DIM * BROADPHASE_GRID_DIM)
+#define BROADPHASE_NO_CELL      0xFFFFu
+
+struct broadphase {
+    const struct physicsData *objects;
+    poolIndex_t cellHead[POOL_TYPE_COUNT][BROADPHASE_CELLS]; // one list per object type per cell
+    poolIndex_t next[PHYSICS_MAX_OBJECTS];
+    poolIndex_t prev[PHYSICS_MAX_OBJECTS];
+    uint16_t cell[PHYSICS_MAX_OBJECTS];
+};
+
+void bpInit(struct broadphase *bp, const struct physicsData *objects);
+void bpUpdate(struct broadphase *bp, poolIndex_t index);
+void bpRemove(struct broadphase *bp, poolIndex_t index);
+poolIndex_t bpFindNearby(const struct broadphase *bp, fix16_t x, fix16_t y, fix16_t radius, uint8_t type);
+
+#endif // BROADPHASE_H
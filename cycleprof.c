@@ -0,0 +1,111 @@
+/***************************************************************************//**
+ * @file
+ * @brief Per-phase cycle-count histograms for the physics tick
+ ******************************************************************************/
+
+#include "cycleprof.h"
+
+#if CYCLE_PROFILING
+#include <stdio.h>
+#include <string.h>
+
+struct cycleProfile cycleProfile;
+
+static const char *const phaseNames[CYCLE_PHASE_COUNT] = {
+    "inputs", "slider", "buttons", "spawn", "player", "satchels", "shots", "step", "publish", "restart",
+    "compose", "flush",
+};
+
+/***************************************************************************//**
+ * @brief
+ *   Starts the DWT cycle counter and clears the histograms.
+ ******************************************************************************/
+void cycleProfileInit(void)
+{
+#if defined(__arm__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    memset(&cycleProfile, 0, sizeof(cycleProfile));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Counts one sample of a phase. A handful of instructions: one count
+ *   leading zeros picks the bucket.
+ ******************************************************************************/
+void cycleRecord(enum cyclePhase phase, uint32_t cycles)
+{
+    struct cycleHistogram *h = &cycleProfile.phase[phase];
+    unsigned bucket = cycles ? 32u - (unsigned)__builtin_clz(cycles) : 0u;
+    h->buckets[bucket]++;
+    if (h->count == 0 || cycles < h->min) {
+        h->min = cycles;
+    }
+    if (cycles > h->max) {
+        h->max = cycles;
+    }
+    h->count++;
+    h->total += cycles;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Upper bound of the bucket holding the perMille'th sample, clamped to the
+ *   recorded min and max. Off by at most a factor of two, by construction.
+ ******************************************************************************/
+uint32_t cyclePercentile(const struct cycleHistogram *h, uint32_t perMille)
+{
+    if (h->count == 0) {
+        return 0;
+    }
+    uint64_t target = ((uint64_t)h->count * perMille + 999) / 1000;
+    uint64_t seen = 0;
+    for (unsigned b = 0; b < CYCLE_BUCKETS; b++) {
+        seen += h->buckets[b];
+        if (seen >= target) {
+            uint32_t upper = b == 0 ? 0 : (uint32_t)(((uint64_t)1 << b) - 1);
+            return upper > h->max ? h->max : (upper < h->min ? h->min : upper);
+        }
+    }
+    return h->max;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Handles a pending reset or report request. Called by the physics task
+ *   between steps, so the histograms are never cleared mid-update.
+ ******************************************************************************/
+void cycleProfileService(void (*print)(const char *line))
+{
+    char line[96];
+    if (cycleProfile.reportRequest) {
+        cycleProfile.reportRequest = 0;
+        print("phase        count        min       mean        p99        max\n");
+        for (int p = 0; p < CYCLE_PHASE_COUNT; p++) {
+            const struct cycleHistogram *h = &cycleProfile.phase[p];
+            snprintf(line, sizeof(line), "%-9s %8lu %10lu %10lu %10lu %10lu\n", phaseNames[p],
+                     (unsigned long)h->count, (unsigned long)h->min,
+                     (unsigned long)(h->count ? h->total / h->count : 0),
+                     (unsigned long)cyclePercentile(h, 990), (unsigned long)h->max);
+            print(line);
+        }
+    }
+    if (cycleProfile.resetRequest) {
+        cycleProfile.resetRequest = 0;
+        memset(cycleProfile.phase, 0, sizeof(cycleProfile.phase));
+    }
+}
+
+void cycleProfileRequestReset(void)
+{
+    cycleProfile.resetRequest = 1;
+}
+
+void cycleProfileRequestReport(void)
+{
+    cycleProfile.reportRequest = 1;
+}
+
+#endif // CYCLE_PROFILING
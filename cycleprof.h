@@ -0,0 +1,106 @@
+/***************************************************************************//**
+ * @file
+ * @brief Per-phase cycle-count histograms for the physics tick
+ *******************************************************************************
+ * Each phase of the physics task is timed with the DWT cycle counter and
+ * counted into a log2 histogram (bucket b holds samples of 2^(b-1) to 2^b - 1
+ * cycles) with count, total, min and max. Everything lives in cycleProfile,
+ * so the debugger can read it directly; setting cycleProfile.reportRequest
+ * prints a table with p99 over RTT and resetRequest clears the histograms.
+ * Both are serviced by the physics task. Each phase is recorded by one task
+ * only; the display task records its own frame phases.
+ *
+ * CYCLE_PROFILING defaults to on in debug builds (DEBUG_EFM) and off in
+ * release builds, where the CYCLE_ macros expand to nothing and no code or
+ * data is left. Host builds count nanoseconds instead of cycles.
+ ******************************************************************************/
+
+#ifndef CYCLEPROF_H
+#define CYCLEPROF_H
+#include <stdint.h>
+
+#ifndef CYCLE_PROFILING
+#ifdef DEBUG_EFM
+#define CYCLE_PROFILING 1
+#else
+#define CYCLE_PROFILING 0
+#endif
+#endif
+
+enum cyclePhase {
+    phaseInputs, // sampling the slider, buttons and aim, or the replay
+    phaseSlider, // slider to platform force
+    phaseButtons, // firing, shield and charge/energy handling
+    phaseSpawn, // satchel throw policy
+    phasePlayer, // platform integration
+    phaseSatchels, // due satchel impacts
+    phaseShots, // shot integration and collisions
+    phaseStep, // the whole of physicsStep()
+    phasePublish, // preparing and publishing the snapshot
+    phaseRestart, // reinitializing the game for a new round
+    phaseCompose, // display task: building a frame in the framebuffer
+    phaseFlush, // display task: queueing the changed lines for the LCD, with any wait for a command buffer
+    CYCLE_PHASE_COUNT
+};
+
+#define CYCLE_BUCKETS 33 // 0 cycles, then one bucket per power of two up to 2^32
+
+struct cycleHistogram {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t buckets[CYCLE_BUCKETS];
+};
+
+struct cycleProfile {
+    volatile uint8_t resetRequest; // set from the debugger or cycleProfileRequestReset()
+    volatile uint8_t reportRequest; // set from the debugger or cycleProfileRequestReport()
+    struct cycleHistogram phase[CYCLE_PHASE_COUNT];
+};
+
+#if CYCLE_PROFILING
+
+#if defined(__arm__)
+#include "em_device.h"
+static inline uint32_t cycleNow(void)
+{
+    return DWT->CYCCNT;
+}
+#else
+#include <time.h>
+static inline uint32_t cycleNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
+#endif
+
+extern struct cycleProfile cycleProfile;
+
+void cycleProfileInit(void);
+void cycleRecord(enum cyclePhase phase, uint32_t cycles);
+uint32_t cyclePercentile(const struct cycleHistogram *h, uint32_t perMille);
+void cycleProfileService(void (*print)(const char *line));
+void cycleProfileRequestReset(void);
+void cycleProfileRequestReport(void);
+
+// Start timing into a local; CYCLE_LAP records the phase and restarts it for the next one
+#define CYCLE_BEGIN(mark)        uint32_t mark = cycleNow()
+#define CYCLE_LAP(phase, mark)   do { uint32_t lapNow = cycleNow(); cycleRecord(phase, lapNow - (mark)); (mark) = lapNow; } while (0)
+#define CYCLE_END(phase, mark)   cycleRecord(phase, cycleNow() - (mark))
+#define CYCLE_SERVICE(print)     cycleProfileService(print)
+#define CYCLE_INIT()             cycleProfileInit()
+
+#else
+
+#define CYCLE_BEGIN(mark)
+#define CYCLE_LAP(phase, mark)
+#define CYCLE_END(phase, mark)
+#define CYCLE_SERVICE(print)
+#define CYCLE_INIT()
+
+#endif // CYCLE_PROFILING
+
+#endif // CYCLEPROF_H
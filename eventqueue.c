@@ -0,0 +1,113 @@
+/***************************************************************************//**
+ * @file
+ * @brief Time-ordered queue of scheduled physics events
+ ******************************************************************************/
+
+#include "eventqueue.h"
+
+static void place(struct eventQueue *queue, uint16_t slot, struct physicsEvent event)
+{
+    queue->heap[slot] = event;
+    queue->position[event.index] = slot;
+}
+
+static void siftUp(struct eventQueue *queue, uint16_t slot)
+{
+    struct physicsEvent event = queue->heap[slot];
+    while (slot > 0) {
+        uint16_t parent = (slot - 1) / 2;
+        if (queue->heap[parent].time <= event.time) {
+            break;
+        }
+        place(queue, slot, queue->heap[parent]);
+        slot = parent;
+    }
+    place(queue, slot, event);
+}
+
+static void siftDown(struct eventQueue *queue, uint16_t slot)
+{
+    struct physicsEvent event = queue->heap[slot];
+    for (;;) {
+        uint16_t child = 2 * slot + 1;
+        if (child >= queue->count) {
+            break;
+        }
+        if (child + 1 < queue->count && queue->heap[child + 1].time < queue->heap[child].time) {
+            child++;
+        }
+        if (event.time <= queue->heap[child].time) {
+            break;
+        }
+        place(queue, slot, queue->heap[child]);
+        slot = child;
+    }
+    place(queue, slot, event);
+}
+
+static void removeAt(struct eventQueue *queue, uint16_t slot)
+{
+    queue->position[queue->heap[slot].index] = EVENT_NOT_QUEUED;
+    queue->count--;
+    if (slot == queue->count) {
+        return;
+    }
+    place(queue, slot, queue->heap[queue->count]);
+    // The moved event may belong above or below the hole it fills
+    if (slot > 0 && queue->heap[slot].time < queue->heap[(slot - 1) / 2].time) {
+        siftUp(queue, slot);
+    } else {
+        siftDown(queue, slot);
+    }
+}
+
+void eventQueueInit(struct eventQueue *queue)
+{
+    queue->count = 0;
+    for (int i = 0; i < PHYSICS_MAX_OBJECTS; i++) {
+        queue->position[i] = EVENT_NOT_QUEUED;
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Schedules the next event for an object, replacing any it already had.
+ ******************************************************************************/
+void eventQueueSchedule(struct eventQueue *queue, poolIndex_t index, uint8_t type, fix16_t time)
+{
+    eventQueueCancel(queue, index);
+    struct physicsEvent event = {.time = time, .index = index, .type = type};
+    place(queue, queue->count, event);
+    siftUp(queue, queue->count++);
+}
+
+void eventQueueCancel(struct eventQueue *queue, poolIndex_t index)
+{
+    uint16_t slot = queue->position[index];
+    if (slot != EVENT_NOT_QUEUED) {
+        removeAt(queue, slot);
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Removes the earliest event if it is due at or before now.
+ ******************************************************************************/
+bool eventQueuePopDue(struct eventQueue *queue, fix16_t now, struct physicsEvent *event)
+{
+    if (queue->count == 0 || queue->heap[0].time > now) {
+        return false;
+    }
+    *event = queue->heap[0];
+    removeAt(queue, 0);
+    return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Time of the earliest pending event, FIX16_MAX when there is none.
+ ******************************************************************************/
+fix16_t eventQueueNextTime(const struct eventQueue *queue)
+{
+    return queue->count ? queue->heap[0].time : FIX16_MAX;
+}
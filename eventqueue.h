@@ -0,0 +1,41 @@
+/***************************************************************************//**
+ * @file
+ * @brief Time-ordered queue of scheduled physics events
+ *******************************************************************************
+ * A binary min-heap keyed on event time, indexed by pool slot. Each object has
+ * at most one pending event, so scheduling a new one replaces the old and a
+ * destroyed object's event is cancelled in O(log n) instead of lingering.
+ * The physics tick only pops what is due, so in-flight objects cost nothing
+ * between their events.
+ ******************************************************************************/
+
+#ifndef EVENTQUEUE_H
+#define EVENTQUEUE_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "fixedpoint.h"
+#include "objpool.h"
+
+#define EVENT_NOT_QUEUED 0xFFFFu
+
+enum eventType {groundImpact, wallImpact};
+
+struct physicsEvent {
+    fix16_t time; // s, absolute physics time
+    poolIndex_t index;
+    uint8_t type;
+};
+
+struct eventQueue {
+    uint16_t count;
+    struct physicsEvent heap[PHYSICS_MAX_OBJECTS];
+    uint16_t position[PHYSICS_MAX_OBJECTS]; // Heap slot of each object's event
+};
+
+void eventQueueInit(struct eventQueue *queue);
+void eventQueueSchedule(struct eventQueue *queue, poolIndex_t index, uint8_t type, fix16_t time);
+void eventQueueCancel(struct eventQueue *queue, poolIndex_t index);
+bool eventQueuePopDue(struct eventQueue *queue, fix16_t now, struct physicsEvent *event);
+fix16_t eventQueueNextTime(const struct eventQueue *queue);
+
+#endif // EVENTQUEUE_H
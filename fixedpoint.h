@@ -0,0 +1,158 @@
+/***************************************************************************//**
+ * @file
+ * @brief Q16.16 fixed-point math used by the physics engine
+ *******************************************************************************
+ * All physics state is kept in signed Q16.16 (16 integer bits, 16 fractional
+ * bits). Only integer operations are used so a tick produces bit-identical
+ * results on the Cortex-M4 target and on a Linux x86 host build.
+ ******************************************************************************/
+
+#ifndef FIXEDPOINT_H
+#define FIXEDPOINT_H
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef int32_t fix16_t;
+
+#define FIX16_SHIFT     16
+#define FIX16_ONE       ((fix16_t)1 << FIX16_SHIFT)
+#define FIX16_HALF      ((fix16_t)1 << (FIX16_SHIFT - 1))
+#define FIX16_MAX       ((fix16_t)INT32_MAX)
+#define FIX16_MIN       ((fix16_t)INT32_MIN)
+
+// Compile time conversion of an integer constant
+#define FIX16_FROM_INT(i) ((fix16_t)((int32_t)(i) * FIX16_ONE))
+// Compile time num / den, same result as fix16FromFrac()
+#define FIX16_FROM_FRAC(num, den) ((fix16_t)(((int64_t)(num) * FIX16_ONE) / (den)))
+
+// Reciprocals are Q8.24 so 1 / mass keeps its precision for masses up to 2^24
+#define FIX16_RECIP_SHIFT 24
+#define FIX16_RECIP(den) ((int32_t)(((int64_t)1 << FIX16_RECIP_SHIFT) / (den)))
+
+/***************************************************************************//**
+ * Conversions
+ ******************************************************************************/
+static inline fix16_t fix16FromInt(int32_t i)
+{
+  return (fix16_t)(i * FIX16_ONE);
+}
+
+// Truncates toward negative infinity, matching (int)floor(x)
+static inline int32_t fix16ToInt(fix16_t a)
+{
+  return a >> FIX16_SHIFT;
+}
+
+// Rounds to the nearest integer, used when a pixel coordinate is needed
+static inline int32_t fix16RoundToInt(fix16_t a)
+{
+  return (a + FIX16_HALF) >> FIX16_SHIFT;
+}
+
+// num / den as Q16.16, computed without truncating the fraction
+static inline fix16_t fix16FromFrac(int32_t num, int32_t den)
+{
+  return (fix16_t)(((int64_t)num * FIX16_ONE) / den);
+}
+
+// Only for display and debugging; never feed the result back into the physics
+static inline float fix16ToFloat(fix16_t a)
+{
+  return (float)a / FIX16_ONE;
+}
+
+/***************************************************************************//**
+ * Arithmetic
+ ******************************************************************************/
+static inline fix16_t fix16Mul(fix16_t a, fix16_t b)
+{
+  return (fix16_t)(((int64_t)a * b) >> FIX16_SHIFT);
+}
+
+static inline fix16_t fix16Div(fix16_t a, fix16_t b)
+{
+  return (fix16_t)(((int64_t)a * FIX16_ONE) / b);
+}
+
+// Multiply by a plain integer, e.g. a velocity by a tick count
+static inline fix16_t fix16MulInt(fix16_t a, int32_t i)
+{
+  return (fix16_t)(a * i);
+}
+
+static inline fix16_t fix16Abs(fix16_t a)
+{
+  return a < 0 ? -a : a;
+}
+
+// a + (b - a) * t, t in [0, 1]
+static inline fix16_t fix16Lerp(fix16_t a, fix16_t b, fix16_t t)
+{
+  return a + fix16Mul(b - a, t);
+}
+
+static inline fix16_t fix16Clamp(fix16_t a, fix16_t lo, fix16_t hi)
+{
+  return a < lo ? lo : (a > hi ? hi : a);
+}
+
+/***************************************************************************//**
+ * Integration helpers
+ ******************************************************************************/
+// Acceleration from an integer force (N) and mass (kg). Keeps the fraction that
+// the old integer xForce / mass division dropped.
+static inline fix16_t fix16Accel(int32_t force, int32_t mass)
+{
+  return fix16FromFrac(force, mass);
+}
+
+// Acceleration from an integer force (N) and a FIX16_RECIP() of the mass.
+// A multiply instead of fix16Accel()'s division.
+static inline fix16_t fix16AccelRecip(int32_t force, int32_t recipMass)
+{
+  return (fix16_t)(((int64_t)force * recipMass) >> (FIX16_RECIP_SHIFT - FIX16_SHIFT));
+}
+
+// One explicit Euler step: value += rate * dt
+static inline fix16_t fix16Step(fix16_t value, fix16_t rate, fix16_t dt)
+{
+  return value + fix16Mul(rate, dt);
+}
+
+// Velocity Verlet position update: x + v * dt + a * dt^2 / 2. Exact for a
+// constant acceleration; follow it with fix16Step() on the velocity.
+static inline fix16_t fix16VerletStep(fix16_t x, fix16_t v, fix16_t a, fix16_t dt)
+{
+  return x + fix16Mul(v, dt) + fix16Mul(fix16Mul(a, dt), dt) / 2;
+}
+
+// Squared distance between two points, widened to 64 bits so the canyon-scale
+// coordinates cannot overflow. Result is Q32.32.
+static inline int64_t fix16DistSq(fix16_t x0, fix16_t y0, fix16_t x1, fix16_t y1)
+{
+  int64_t dx = (int64_t)x1 - x0;
+  int64_t dy = (int64_t)y1 - y0;
+  return dx * dx + dy * dy;
+}
+
+// True when (x1, y1) lies within range of (x0, y0). Replaces sqrt() on the hot path.
+static inline bool fix16WithinRange(fix16_t x0, fix16_t y0, fix16_t x1, fix16_t y1, fix16_t range)
+{
+  return fix16DistSq(x0, y0, x1, y1) <= (int64_t)range * range;
+}
+
+// Smallest shift k <= maxShift such that moving at (xVel, yVel) for dt >> k
+// covers at most maxTravel. An object then takes 1 << k substeps per step.
+static inline int fix16SubstepShift(fix16_t xVel, fix16_t yVel, fix16_t dt, fix16_t maxTravel, int maxShift)
+{
+  int64_t travelSq = fix16DistSq(0, 0, fix16Mul(xVel, dt), fix16Mul(yVel, dt));
+  int64_t limitSq = (int64_t)maxTravel * maxTravel;
+  int k = 0;
+  while (k < maxShift && travelSq > limitSq) {
+    limitSq <<= 2; // (2 * maxTravel)^2
+    k++;
+  }
+  return k;
+}
+
+#endif // FIXEDPOINT_H
@@ -0,0 +1,23 @@
+/***************************************************************************//**
+ * @file
+ * @brief 1bpp framebuffers for the 128x128 memory LCD
+ ******************************************************************************/
+
+#include "framebuf.h"
+
+/***************************************************************************//**
+ * @brief
+ *   Copies a whole frame a word at a time. Both buffers must be word
+ *   aligned; the library memcpy() may go a byte at a time.
+ ******************************************************************************/
+void framebufCopy(void *dst, const void *src)
+{
+    uint32_t *d = dst;
+    const uint32_t *s = src;
+    for (int i = 0; i < FRAMEBUF_WORDS; i += 4) {
+        d[i] = s[i];
+        d[i + 1] = s[i + 1];
+        d[i + 2] = s[i + 2];
+        d[i + 3] = s[i + 3];
+    }
+}
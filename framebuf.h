@@ -0,0 +1,22 @@
+/***************************************************************************//**
+ * @file
+ * @brief 1bpp framebuffers for the 128x128 memory LCD
+ *******************************************************************************
+ * Same layout as the DMD framebuffer: LCD_HEIGHT lines of LCD_LINE_BYTES,
+ * first pixel of a line in the least significant bit. Buffers declared with
+ * FRAMEBUF_WORDS are word aligned, so whole frames move a word at a time.
+ ******************************************************************************/
+
+#ifndef FRAMEBUF_H
+#define FRAMEBUF_H
+#include <stdint.h>
+
+#define LCD_WIDTH       128
+#define LCD_HEIGHT      128
+#define LCD_LINE_BYTES  (LCD_WIDTH / 8)
+#define LCD_LINE_WORDS  (LCD_LINE_BYTES / 4)
+#define FRAMEBUF_WORDS  (LCD_HEIGHT * LCD_LINE_WORDS)
+
+void framebufCopy(void *dst, const void *src);
+
+#endif // FRAMEBUF_H
@@ -0,0 +1,58 @@
+/***************************************************************************//**
+ * @file
+ * @brief Motion-adaptive display frame rate
+ ******************************************************************************/
+
+#include <string.h>
+#include "framerate.h"
+
+void frameRateInit(struct frameRate *fr, const struct frameRateConfig *config)
+{
+    memset(fr, 0, sizeof(*fr));
+    fr->config = *config;
+    fr->stats.period = config->maxPeriod;
+    fr->stats.rate = config->maxPeriod ? (1000 + config->maxPeriod / 2) / config->maxPeriod : 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Picks the interval to the next frame, in ms, for objects in flight and a
+ *   fastest speed of maxSpeed pixels per second along either axis.
+ ******************************************************************************/
+uint32_t frameRatePick(struct frameRate *fr, uint32_t objects, fix16_t maxSpeed)
+{
+    const struct frameRateConfig *c = &fr->config;
+    uint32_t minPeriod = c->minPeriod ? c->minPeriod : 1;
+    uint32_t maxPeriod = c->maxPeriod > minPeriod ? c->maxPeriod : minPeriod;
+    uint32_t target = maxPeriod;
+    if (maxSpeed > 0) {
+        uint64_t period = ((uint64_t)c->motionPixels * 1000 << FIX16_SHIFT) / (uint32_t)maxSpeed;
+        target = period < target ? (uint32_t)period : target;
+    }
+    if (objects >= c->busyObjects) {
+        target = minPeriod;
+    } else {
+        uint32_t period = maxPeriod - (maxPeriod - minPeriod) * objects / c->busyObjects;
+        target = period < target ? period : target;
+    }
+    target = target < minPeriod ? minPeriod : target;
+    uint32_t period = fr->stats.period;
+    if (target <= period || period < minPeriod) {
+        period = target;
+    } else {
+        period += (target - period + 3) / 4;
+    }
+    fr->stats.period = period;
+    fr->stats.rate = (1000 + period / 2) / period;
+    return period;
+}
+
+void frameRateRecord(struct frameRate *fr, uint32_t micros)
+{
+    fr->stats.frames++;
+    fr->stats.frameMicros = micros;
+    fr->stats.frameMicrosTotal += micros;
+    if (micros > fr->stats.frameMicrosMax) {
+        fr->stats.frameMicrosMax = micros;
+    }
+}
@@ -0,0 +1,48 @@
+/***************************************************************************//**
+ * @file
+ * @brief Motion-adaptive display frame rate
+ *******************************************************************************
+ * The display task asks for the interval to its next frame from what is on
+ * the field: with nothing moving it idles at maxPeriod; the faster the
+ * fastest object moves, the shorter the interval, so that nothing travels
+ * more than motionPixels between frames; and the more objects are in
+ * flight, the shorter still, down to minPeriod with busyObjects of them.
+ * A busier field takes effect on the next frame, a quieter one is eased
+ * into by a quarter of the difference per frame so the rate does not
+ * flicker between two values.
+ *
+ * The chosen period and rate, and the time taken by each composed frame,
+ * are kept in the stats for the debugger.
+ ******************************************************************************/
+
+#ifndef FRAMERATE_H
+#define FRAMERATE_H
+#include <stdint.h>
+#include "fixedpoint.h"
+
+struct frameRateConfig {
+    uint32_t minPeriod; // ms, the bound for the busiest field
+    uint32_t maxPeriod; // ms, the bound for a still field
+    uint32_t motionPixels; // most an object should move between frames
+    uint32_t busyObjects; // objects in flight that on their own call for minPeriod
+};
+
+struct frameRateStats {
+    uint32_t period; // ms, chosen for the next frame
+    uint32_t rate; // frames per second at that period, rounded
+    uint32_t frames; // frames recorded with frameRateRecord()
+    uint32_t frameMicros; // time taken by the latest of them
+    uint32_t frameMicrosMax;
+    uint64_t frameMicrosTotal;
+};
+
+struct frameRate {
+    struct frameRateConfig config;
+    struct frameRateStats stats;
+};
+
+void frameRateInit(struct frameRate *fr, const struct frameRateConfig *config);
+uint32_t frameRatePick(struct frameRate *fr, uint32_t objects, fix16_t maxSpeed);
+void frameRateRecord(struct frameRate *fr, uint32_t micros);
+
+#endif // FRAMERATE_H
@@ -0,0 +1,547 @@
+/***************************************************************************//**
+ * @file
+ * @brief Target independent game engine: one physics step at a time
+ ******************************************************************************/
+
+#include <string.h>
+#include "game.h"
+#include "cycleprof.h"
+
+/***************************************************************************//**
+ * @brief
+ *   xorshift32. Same sequence on the target and the host, unlike rand().
+ ******************************************************************************/
+static uint32_t gameRandom(struct gameState *state)
+{
+    uint32_t x = state->random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state->random = x;
+    return x;
+}
+/***************************************************************************//**
+ * @brief
+ *   Fills in the step constants for constants that are not in the profile
+ *   table (a replay or the host tuner). Same STEP_ macros as the table, so a
+ *   profile gives identical values either way.
+ ******************************************************************************/
+static void deriveStepConstants(struct gameState *state)
+{
+    const struct physicsConstants *c = state->consts;
+    struct stepConstants *s = &state->step;
+    s->dt = STEP_DT(c->physicsPeriod);
+    s->gravityAcc = FIX16_FROM_INT(GRAVITY);
+    s->chargePerTick = STEP_CHARGE_PER_TICK(c->generatorConst.maxShotPower, c->physicsPeriod);
+    s->platformForce = c->platformConst.maxPlatformForce;
+    s->halfPlatformForce = c->platformConst.maxPlatformForce / 2;
+    s->platformInvMass = FIX16_RECIP(c->platformConst.platformMass);
+    s->shotInvMass = FIX16_RECIP(c->railGunConst.shotMass);
+    s->maxShotCharge = c->generatorConst.maxShotPower * JOULES_PER_KJ;
+    s->energyCapacity = c->generatorConst.energyCapacity * JOULES_PER_KJ;
+    s->shieldEnergy = c->shieldConst.shieldActivationEnergy * JOULES_PER_KJ;
+    s->castleHeight = fix16FromInt(c->castleConst.castleHeight);
+    s->canyonSize = fix16FromInt(c->canyonSize);
+    s->satchelRadius = fix16FromInt(c->satchelConst.satchelDisplayDiameter / 2);
+    s->halfPlatform = fix16FromInt(c->platformConst.platformLength / 2);
+    s->platformLength = fix16FromInt(c->platformConst.platformLength);
+    s->maxPlatformSpeed = fix16FromInt(c->platformConst.maxPlatformSpeed);
+    s->shieldRange = fix16FromInt(c->shieldConst.shieldEffectiveRange);
+    s->interceptRange = fix16FromInt(c->railGunConst.shotRadius + c->satchelConst.satchelDisplayDiameter / 2);
+}
+/***************************************************************************//**
+ * @brief
+ *   Spawns satchel.
+ ******************************************************************************/
+static void spawnSatchel(struct gameState *state, struct physicsData *phys)
+{
+    const struct physicsConstants *c = state->consts;
+    // Decide random landing spot. Allow for beyond canyon size to give a chance to bounce off of wall
+    int landingSpot = (int)(gameRandom(state) % (uint32_t)(c->canyonSize / 3));
+    if (gameRandom(state) % 2) { // Randomly make landing spot negative
+        landingSpot = landingSpot * -1;
+    }
+    landingSpot = landingSpot + fix16ToInt(state->objects[0].x); // Landing spot is relative to player
+    // Calculate random flight duration from 1000ms to 5000ms
+    int flightDurationMs = (int)(gameRandom(state) % 4000) + 1000;
+    // Calculate X speed to arrive in flight duration time
+    fix16_t xSpeed = fix16FromFrac(landingSpot * 1000, flightDurationMs);
+    // Calculate Y speed to arrive in flight duration time: -h / t - g * t / 2
+    fix16_t ySpeed = fix16FromFrac(-c->castleConst.castleHeight * 1000, flightDurationMs)
+                   - fix16FromFrac(GRAVITY * flightDurationMs, 2000);
+
+    phys->objectType = satchel;
+    phys->x = 0;
+    phys->y = state->step.castleHeight;
+    phys->xVel = xSpeed;
+    phys->yVel = ySpeed;
+    phys->xForce = 0;
+    phys->yForce = 0;
+    phys->mass = c->satchelConst.satchelWeight;
+}
+/***************************************************************************//**
+ * @brief
+ *   Queues whichever comes first on a satchel's current path: the right wall or
+ *   the ground. Solved once per path instead of tested every step.
+ ******************************************************************************/
+static void scheduleSatchelImpact(struct gameState *state, poolIndex_t index)
+{
+    const struct stepConstants *s = &state->step;
+    fix16_t groundTime = trajectoryTimeToHeight(&state->satchelPaths[index], s->gravityAcc, -s->satchelRadius);
+    fix16_t wallTime = trajectoryTimeToX(&state->satchelPaths[index], s->canyonSize - s->satchelRadius);
+    if (wallTime < groundTime) {
+        eventQueueSchedule(&state->impactEvents, index, wallImpact, wallTime);
+    } else {
+        eventQueueSchedule(&state->impactEvents, index, groundImpact, groundTime);
+    }
+}
+/***************************************************************************//**
+ * @brief
+ *   Takes a slot from the pool and throws a satchel from it, if one is free.
+ ******************************************************************************/
+static void throwSatchel(struct gameState *state)
+{
+    poolIndex_t index = poolAlloc(&state->pool, satchel);
+    if (index != POOL_NONE) {
+        struct physicsData *obj = &state->objects[index];
+        spawnSatchel(state, obj);
+        trajectoryStart(&state->satchelPaths[index], state->time, obj->x, obj->y, obj->xVel, obj->yVel);
+        scheduleSatchelImpact(state, index);
+        bpUpdate(&state->grid, index);
+        state->game.satchelsThrown++;
+    }
+}
+/***************************************************************************//**
+ * @brief
+ *   Clears physics data. Called whenever an object is destroyed.
+ ******************************************************************************/
+static void clearPhysicsData(struct gameState *state, poolIndex_t index)
+{
+    state->previous[index].objectType = empty;
+    eventQueueCancel(&state->impactEvents, index);
+    bpRemove(&state->grid, index);
+    poolFree(&state->pool, index);
+}
+/***************************************************************************//**
+ * @brief
+ *   Records where each live object is before a step, so the display can
+ *   interpolate between the last two steps.
+ ******************************************************************************/
+static void rememberPositions(struct gameState *state)
+{
+    static const uint8_t types[] = {player, shot}; // Satchels are evaluated in gamePrepareFrame()
+    for (unsigned t = 0; t < sizeof(types); t++) {
+        for (poolIndex_t i = poolFirst(&state->pool, types[t]); i != POOL_NONE; i = poolNext(&state->pool, i)) {
+            state->previous[i].objectType = state->objects[i].objectType;
+            state->previous[i].x = state->objects[i].x;
+            state->previous[i].y = state->objects[i].y;
+        }
+    }
+}
+/***************************************************************************//**
+ * @brief
+ *   Evaluates every satchel's path at the current time and refreshes the
+ *   broadphase. Skipped when nothing has moved since the last call.
+ ******************************************************************************/
+static void updateSatchelPositions(struct gameState *state)
+{
+    if (state->satchelPositionsCurrent) {
+        return;
+    }
+    for (poolIndex_t i = poolFirst(&state->pool, satchel); i != POOL_NONE; i = poolNext(&state->pool, i)) {
+        struct physicsData *obj = &state->objects[i];
+        trajectoryEval(&state->satchelPaths[i], state->step.gravityAcc, state->time, &obj->x, &obj->y, &obj->xVel, &obj->yVel);
+        bpUpdate(&state->grid, i);
+    }
+    state->satchelPositionsCurrent = true;
+}
+/***************************************************************************//**
+ * @brief
+ *   Handles a satchel reaching the wall or the ground. Bouncing starts a new
+ *   path from the exact impact point, so the timing does not depend on dt.
+ ******************************************************************************/
+static void resolveSatchelImpact(struct gameState *state, const struct physicsEvent *event)
+{
+    struct trajectory *path = &state->satchelPaths[event->index];
+    fix16_t x, y, yVel;
+    trajectoryEval(path, state->step.gravityAcc, event->time, &x, &y, NULL, &yVel);
+    if (event->type == wallImpact) { // bounce off wall
+        trajectoryStart(path, event->time, x, y, -path->xVel, yVel);
+        scheduleSatchelImpact(state, event->index);
+        return;
+    }
+    fix16_t halfPlatform = state->step.halfPlatform;
+    if (x > state->objects[0].x - halfPlatform && x < state->objects[0].x + halfPlatform) { // Lose on hit
+        state->game.state = fail;
+    }
+    clearPhysicsData(state, event->index); // Destroy on ground
+}
+/***************************************************************************//**
+ * @brief
+ *   Checks a shot against the castle, the ground and the satchels, clearing
+ *   what it hits. Returns true when the shot is gone.
+ ******************************************************************************/
+static bool shotCollides(struct gameState *state, poolIndex_t index)
+{
+    const struct stepConstants *s = &state->step;
+    struct gameData *game = &state->game;
+    const struct physicsData *obj = &state->objects[index];
+    if (obj->x <= 0 && obj->y >= s->castleHeight && obj->y <= s->canyonSize) { // hit
+        clearPhysicsData(state, index);
+        game->foundationDamage++;
+        if (game->foundationDamage >= state->consts->castleConst.foundationHitsRequired) {
+            game->state = win;
+        }
+        return true;
+    }
+    if (obj->y <= 0 || (obj->x <= 0 && obj->y < s->castleHeight)) { // Destroy on ground or below castle
+        clearPhysicsData(state, index);
+        return true;
+    }
+    // Shots intercept satchels mid-air. Both are destroyed.
+    poolIndex_t hit = bpFindNearby(&state->grid, obj->x, obj->y, s->interceptRange, satchel);
+    if (hit != POOL_NONE) {
+        clearPhysicsData(state, hit);
+        clearPhysicsData(state, index);
+        game->satchelsIntercepted++;
+        return true;
+    }
+    return false;
+}
+/***************************************************************************//**
+ * @brief
+ *   Starts a game: empty pool, the player in slot 0 mid-canyon, full energy.
+ ******************************************************************************/
+static void gameStart(struct gameState *state, const struct physicsConstants *consts, uint32_t seed)
+{
+    struct gameData localDat = {
+        .state = active, // use states enum
+        .energy = consts->generatorConst.energyCapacity * JOULES_PER_KJ,
+        .shotCharge = 0,
+        .foundationDamage = 0,
+        .evacComplete = false,
+        .satchelsThrown = 0,
+        .shieldsActivated = 0,
+        .usefulShields = 0,
+        .shotsFired = 0
+    };
+    state->consts = consts;
+    state->game = localDat;
+    poolInit(&state->pool, state->objects);
+    memset(state->previous, 0, sizeof(state->previous));
+    bpInit(&state->grid, state->objects);
+    eventQueueInit(&state->impactEvents);
+    state->time = 0;
+    state->satchelPositionsCurrent = true;
+    state->charging = false;
+    state->timer = 0;
+    state->ticks = 0;
+    state->random = seed ? seed : GAME_DEFAULT_SEED; // xorshift never leaves zero
+    poolAlloc(&state->pool, player); // First allocation, so the player is slot 0
+    state->objects[0].x = fix16FromInt(consts->canyonSize / 2);
+    state->objects[0].y = 0;
+    state->objects[0].mass = consts->platformConst.platformMass;
+}
+/***************************************************************************//**
+ * @brief
+ *   Starts a game with one of the compile time profiles. Its step constants
+ *   are used as they are.
+ ******************************************************************************/
+void gameInitProfile(struct gameState *state, int profile, uint32_t seed)
+{
+    gameStart(state, &physicsProfiles[profile].consts, seed);
+    state->step = physicsProfiles[profile].step;
+    state->game.profile = profile;
+}
+/***************************************************************************//**
+ * @brief
+ *   Starts a game with any constants, deriving the step constants once.
+ ******************************************************************************/
+void gameInit(struct gameState *state, const struct physicsConstants *consts, uint32_t seed)
+{
+    gameStart(state, consts, seed);
+    deriveStepConstants(state);
+    state->game.profile = GAME_CUSTOM_PROFILE;
+}
+/***************************************************************************//**
+ * @brief
+ *   Advances the game by dt. Does nothing once the game is won or lost.
+ ******************************************************************************/
+void physicsStep(struct gameState *state, const struct gameInputs *inputs, fix16_t dt)
+{
+    if (state->game.state != active) {
+        return;
+    }
+    if (dt != state->step.dt) {
+        // Off the profile's period: only the per step charge depends on dt. maxShotPower * dt / 1.5, in J
+        state->step.dt = dt;
+        state->step.chargePerTick = (int32_t)(((int64_t)state->consts->generatorConst.maxShotPower * 2 * JOULES_PER_KJ * dt
+                                               + 3 * FIX16_HALF) / (3 * FIX16_ONE));
+    }
+    const struct physicsConstants *c = state->consts;
+    const struct stepConstants *s = &state->step;
+    struct gameData *game = &state->game;
+    struct physicsData *objects = state->objects;
+    CYCLE_BEGIN(mark);
+    state->ticks++;
+    rememberPositions(state);
+    game->shieldActive = false;
+    game->evacComplete = inputs->evacComplete;
+    // Use slider data to calculate platform force
+    if ((inputs->farLeft || inputs->left) && (inputs->farRight || inputs->right)) {
+        // do Nothing
+    } else if (inputs->left) {
+        objects[0].xForce += -s->halfPlatformForce;
+    } else if (inputs->right) {
+        objects[0].xForce += s->platformForce;
+    } else if (inputs->farLeft) {
+        objects[0].xForce += -s->platformForce;
+    } else if (inputs->farRight) {
+        objects[0].xForce += s->halfPlatformForce;
+    } else { // no slider input, apply friction
+        if (objects[0].xVel > 0) {
+            objects[0].xForce += -s->platformForce;
+        } else if (objects[0].xVel < 0) {
+            objects[0].xForce += s->platformForce;
+        }
+    }
+    CYCLE_LAP(phaseSlider, mark);
+    // Use button data to calculate shot charge
+    if (inputs->charge) { // Start charging
+        state->charging = true;
+    } else if (state->charging == true) { // Fire shot
+        state->charging = false;
+        poolIndex_t j;
+        if (game->shotCharge > 0 && (j = poolAlloc(&state->pool, shot)) != POOL_NONE) {
+            fix16_t shotSpeed = fix16MulInt(fix16FromFrac(game->shotCharge, s->maxShotCharge), 100);
+            objects[j].x = objects[0].x;
+            objects[j].y = FIX16_ONE;
+            objects[j].xVel = fix16Mul(shotSpeed, angleCos(inputs->aim));
+            objects[j].yVel = -fix16Mul(shotSpeed, angleSin(inputs->aim));
+            objects[j].mass = c->railGunConst.shotMass;
+            bpUpdate(&state->grid, j);
+            objects[0].xForce += 50000;
+            game->shotCharge = 0;
+            game->shotsFired++;
+        }
+    }
+    // Use button data to calculate shield activation. Destroy all satchels in range
+    if (inputs->shield && game->energy >= s->shieldEnergy) {
+        game->energy -= s->shieldEnergy;
+        game->shieldsActivated++;
+        game->shieldActive = true;
+        updateSatchelPositions(state);
+        poolIndex_t i;
+        while ((i = bpFindNearby(&state->grid, objects[0].x, objects[0].y, s->shieldRange, satchel)) != POOL_NONE) {
+            clearPhysicsData(state, i);
+            game->usefulShields++;
+        }
+    }
+    // If charging, add charge and reduce energy. Otherwise, charge energy
+    if (state->charging == true && game->energy > 0 && game->shotCharge < s->maxShotCharge) {
+        game->shotCharge += s->chargePerTick;
+        game->energy -= s->chargePerTick;
+    } else if (state->charging == true && game->energy == 0) {
+        // Do nothing
+    } else if (state->charging == false && game->energy >= s->energyCapacity) {
+        game->energy = s->energyCapacity;
+    } else if (state->charging == false && game->energy <= s->energyCapacity) {
+        game->energy += s->chargePerTick;
+    }
+    CYCLE_LAP(phaseButtons, mark);
+    // Check if satchel should be spawned
+    switch (c->satchelConst.limitingMethod) {
+      case AlwaysOne:
+          // If there is no satchel in flight, create one
+          if (poolCount(&state->pool, satchel) == 0) {
+              throwSatchel(state);
+          }
+          break;
+      case MaxInFlight:
+          // Check if # of satchels in flight is less than max
+          if(0 == 1) {}; // Allow for compilation due to label error
+          int satchelCount = poolCount(&state->pool, satchel);
+          state->timer++;
+          if (satchelCount >= c->satchelConst.maxInFlight) {
+              state->timer = 0;
+          }
+          if (satchelCount < c->satchelConst.maxInFlight && !(state->timer % c->satchelConst.maxInFlightPeriod)) { // If there are less than max, create a satchel
+                throwSatchel(state);
+          }
+          break;
+      case PeriodicThrowTime:
+          // Check if it is time to throw a satchel
+          if(0 == 1) {}; // Allow for compilation due to label error
+          if ((state->timer % c->satchelConst.throwPeriod) == 0) {
+                throwSatchel(state);
+          }
+          state->timer++;
+          break;
+      default:
+          while (1) {}
+          // Shouldn't be here
+          break;
+    }
+    CYCLE_LAP(phaseSpawn, mark);
+    // Unique physics calculations for each object type
+    // Player physics. The player is allocated first and always lives in slot 0.
+    {
+        struct physicsData *obj = &objects[0];
+        fix16_t xAcc = fix16AccelRecip(obj->xForce, s->platformInvMass); // F = ma
+        obj->xVel = fix16Clamp(fix16Step(obj->xVel, xAcc, dt), -s->maxPlatformSpeed, s->maxPlatformSpeed);
+        obj->x = fix16Step(obj->x, obj->xVel, dt);
+        obj->xForce = 0; // Forces aren't constant, so they need to be reset
+        // Bounce off the walls: mirror the platform back inside, heading away from the wall. A
+        // step longer than the room left is clamped, so x never leaves the canyon.
+        fix16_t left = s->halfPlatform;
+        fix16_t right = s->canyonSize - s->halfPlatform > left ? s->canyonSize - s->halfPlatform : left;
+        if (obj->x < left) {
+            obj->xVel = fix16Abs(obj->xVel);
+            obj->x = fix16Clamp(left + (left - obj->x), left, right);
+        } else if (obj->x > right) {
+            obj->xVel = -fix16Abs(obj->xVel);
+            obj->x = fix16Clamp(right - (obj->x - right), left, right);
+        }
+    }
+    CYCLE_LAP(phasePlayer, mark);
+    // Satchel physics. Nothing is integrated; only impacts that fell due this step are handled.
+    state->time += dt;
+    state->satchelPositionsCurrent = poolCount(&state->pool, satchel) == 0;
+    struct physicsEvent impact;
+    while (eventQueuePopDue(&state->impactEvents, state->time, &impact)) {
+        resolveSatchelImpact(state, &impact);
+    }
+    CYCLE_LAP(phaseSatchels, mark);
+    // Shot physics, after the satchels so a shot meets them where they are now
+    if (poolCount(&state->pool, shot) > 0) {
+        updateSatchelPositions(state);
+    }
+    for (poolIndex_t i = poolFirst(&state->pool, shot), next; i != POOL_NONE; i = next) {
+        next = poolNext(&state->pool, i);
+        struct physicsData *obj = &objects[i];
+        fix16_t xAcc = fix16AccelRecip(obj->xForce, s->shotInvMass);
+        fix16_t yAcc = fix16AccelRecip(obj->yForce, s->shotInvMass) + s->gravityAcc;
+        obj->yForce = 0; // Forces aren't constant, so they need to be reset
+        obj->xForce = 0; // Forces aren't constant, so they need to be reset
+        // Fast shots get substeps short enough that they cannot pass through a satchel or the castle edge
+        int shift = fix16SubstepShift(obj->xVel, obj->yVel, dt, s->interceptRange, SHOT_MAX_SUBSTEP_SHIFT);
+        fix16_t h = dt >> shift;
+        bool alive = true;
+        for (int n = 1 << shift; n > 0 && alive; n--) {
+            if (n == 1) {
+                h = dt - (h << shift) + h; // The last substep takes what the shift dropped
+            }
+            obj->x = fix16VerletStep(obj->x, obj->xVel, xAcc, h);
+            obj->y = fix16VerletStep(obj->y, obj->yVel, yAcc, h);
+            obj->xVel = fix16Step(obj->xVel, xAcc, h);
+            obj->yVel = fix16Step(obj->yVel, yAcc, h);
+            alive = !shotCollides(state, i);
+        }
+        if (alive) {
+            bpUpdate(&state->grid, i);
+        }
+    }
+    CYCLE_END(phaseShots, mark);
+}
+/***************************************************************************//**
+ * @brief
+ *   How many of the coming steps would only advance the clock if run with
+ *   these inputs: nothing charging or firing, no shots, the platform at rest
+ *   and no satchel thrown or landing. Satchels in flight do not count as
+ *   motion; their paths are closed form. Capped at GAME_MAX_QUIET_STEPS.
+ ******************************************************************************/
+uint32_t gameQuietSteps(const struct gameState *state, const struct gameInputs *inputs)
+{
+    const struct physicsConstants *c = state->consts;
+    const struct stepConstants *s = &state->step;
+    const struct physicsData *player = &state->objects[0];
+    if (state->game.state != active || state->charging || inputs->charge || inputs->shield
+        || inputs->farLeft || inputs->left || inputs->right || inputs->farRight
+        || player->xVel != 0 || player->x + s->halfPlatform < 0 || player->x + s->halfPlatform > s->canyonSize
+        || poolCount(&state->pool, shot) > 0) {
+        return 0;
+    }
+    uint32_t quiet = GAME_MAX_QUIET_STEPS;
+    // Steps before the one that throws the next satchel
+    int satchels = poolCount(&state->pool, satchel);
+    switch (c->satchelConst.limitingMethod) {
+      case AlwaysOne:
+          if (satchels == 0) {
+              return 0;
+          }
+          break;
+      case MaxInFlight:
+          if (satchels < c->satchelConst.maxInFlight) {
+              int period = c->satchelConst.maxInFlightPeriod;
+              quiet = (uint32_t)((period - (state->timer + 1) % period) % period);
+          }
+          break;
+      case PeriodicThrowTime: {
+          int period = c->satchelConst.throwPeriod;
+          quiet = (uint32_t)((period - state->timer % period) % period);
+          break;
+      }
+      default:
+          return 0;
+    }
+    // Steps before the one that handles the next impact
+    fix16_t next = eventQueueNextTime(&state->impactEvents);
+    if (next != FIX16_MAX) {
+        fix16_t ahead = next - state->time;
+        uint32_t beforeImpact = ahead > 0 ? (uint32_t)((ahead - 1) / s->dt) : 0;
+        quiet = beforeImpact < quiet ? beforeImpact : quiet;
+    }
+    return quiet;
+}
+/***************************************************************************//**
+ * @brief
+ *   Advances the game by count steps that gameQuietSteps() allowed for the
+ *   same inputs. The result is what physicsStep() would have produced.
+ ******************************************************************************/
+void gameSkipSteps(struct gameState *state, const struct gameInputs *inputs, uint32_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    const struct stepConstants *s = &state->step;
+    struct gameData *game = &state->game;
+    state->ticks += count;
+    rememberPositions(state);
+    game->shieldActive = false;
+    game->evacComplete = inputs->evacComplete;
+    // Generator recharge: chargePerTick a step until full, then clamped
+    if (game->energy >= s->energyCapacity) {
+        game->energy = s->energyCapacity;
+    } else {
+        uint32_t toFull = (uint32_t)((s->energyCapacity - game->energy + s->chargePerTick - 1) / s->chargePerTick);
+        game->energy = count <= toFull ? game->energy + (int32_t)count * s->chargePerTick : s->energyCapacity;
+    }
+    if (state->consts->satchelConst.limitingMethod == MaxInFlight
+        && poolCount(&state->pool, satchel) >= state->consts->satchelConst.maxInFlight) {
+        state->timer = 0;
+    } else if (state->consts->satchelConst.limitingMethod != AlwaysOne) {
+        state->timer += (int)count;
+    }
+    state->time += fix16MulInt(s->dt, (int32_t)count);
+    state->satchelPositionsCurrent = poolCount(&state->pool, satchel) == 0;
+}
+/***************************************************************************//**
+ * @brief
+ *   Brings satchels up to date before the state is published or inspected,
+ *   including where they were one step back so the display can interpolate
+ *   them like the integrated objects.
+ ******************************************************************************/
+void gamePrepareFrame(struct gameState *state)
+{
+    updateSatchelPositions(state);
+    fix16_t before = state->time - state->step.dt;
+    for (poolIndex_t i = poolFirst(&state->pool, satchel); i != POOL_NONE; i = poolNext(&state->pool, i)) {
+        struct objectPosition *prev = &state->previous[i];
+        if (state->satchelPaths[i].startTime > before) {
+            prev->objectType = empty; // Thrown or bounced this step, draw where it is
+            continue;
+        }
+        prev->objectType = satchel;
+        trajectoryEval(&state->satchelPaths[i], state->step.gravityAcc, before, &prev->x, &prev->y, NULL, NULL);
+    }
+}
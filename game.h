@@ -0,0 +1,70 @@
+/***************************************************************************//**
+ * @file
+ * @brief Target independent game engine: one physics step at a time
+ *******************************************************************************
+ * Everything the physics task used to keep in globals lives in struct
+ * gameState, and everything it used to read from the slider, buttons and
+ * railgun aim is passed in struct gameInputs. physicsStep() touches nothing
+ * else, so the same code runs in the Micrium physics task and in the host
+ * tools (host/libgame.a). Satchels are thrown from a seeded generator so a
+ * seed plus an input sequence always replays the same game.
+ ******************************************************************************/
+
+#ifndef GAME_H
+#define GAME_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "fixedpoint.h"
+#include "angle.h"
+#include "physics.h"
+#include "profiles.h"
+#include "objpool.h"
+#include "broadphase.h"
+#include "trajectory.h"
+#include "eventqueue.h"
+
+#define GAME_DEFAULT_SEED 1u
+#define GAME_CUSTOM_PROFILE -1 // gameData.profile when started from loose constants
+#define SHOT_MAX_SUBSTEP_SHIFT 3 // A shot takes at most 8 substeps per physics step
+#define GAME_MAX_QUIET_STEPS 200 // Longest stretch gameQuietSteps() reports
+
+// Inputs sampled once per step
+struct gameInputs {
+    bool farLeft; // slider
+    bool left;
+    bool right;
+    bool farRight;
+    bool charge; // railgun charges while held and fires on release
+    bool shield; // activate the shield this step
+    bool evacComplete; // owned by the LED1 task, copied into gameData
+    angle_t aim; // railgun aim for a shot fired this step
+};
+
+struct gameState {
+    const struct physicsConstants *consts;
+    struct stepConstants step;
+    struct gameData game;
+    struct physicsData objects[PHYSICS_MAX_OBJECTS];
+    struct objectPosition previous[PHYSICS_MAX_OBJECTS]; // state one step back, for interpolation
+    struct objectPool pool; // free list and per-type lists over objects
+    struct broadphase grid; // shots and satchels in flight
+    // Satchels fly on closed-form paths. Their objects[] position is only brought up to
+    // date when something needs it: a shield, a shot in flight or gamePrepareFrame().
+    struct trajectory satchelPaths[PHYSICS_MAX_OBJECTS];
+    struct eventQueue impactEvents; // next ground or wall impact of each satchel
+    fix16_t time; // s since the game started
+    bool satchelPositionsCurrent; // objects[] satchel positions are at time
+    bool charging;
+    int timer; // satchel throw timer, in steps
+    uint32_t ticks;
+    uint32_t random;
+};
+
+void gameInitProfile(struct gameState *state, int profile, uint32_t seed);
+void gameInit(struct gameState *state, const struct physicsConstants *consts, uint32_t seed);
+void physicsStep(struct gameState *state, const struct gameInputs *inputs, fix16_t dt);
+uint32_t gameQuietSteps(const struct gameState *state, const struct gameInputs *inputs);
+void gameSkipSteps(struct gameState *state, const struct gameInputs *inputs, uint32_t count);
+void gamePrepareFrame(struct gameState *state);
+
+#endif // GAME_H
@@ -0,0 +1,61 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host benchmark: binary-angle table trig vs the libm path it replaced
+ *******************************************************************************
+ * The old code evaluated cos()/sin() on railgunAngle * 3.14159 / 180 in double
+ * precision for every shot and every cannon line. This times that against
+ * angleCos()/angleSin() and reports the worst table error.
+ ******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "angle.h"
+#include "host_timer.h"
+
+#define ITERATIONS 10000000
+
+static volatile int32_t sink;
+
+int main(int argc, char **argv)
+{
+    long iterations = argc > 1 ? atol(argv[1]) : ITERATIONS;
+    uint64_t start;
+
+    // Reference path, as it was in physicsTask and LCDDisplayTask
+    start = hostTimeNs();
+    for (long i = 0; i < iterations; i++) {
+        int degrees = (int)(i % 360);
+        sink += (int32_t)(16 * cos(degrees * 3.14159 / 180));
+        sink += (int32_t)(16 * sin(degrees * 3.14159 / 180));
+    }
+    uint64_t libmNs = hostTimeNs() - start;
+
+    start = hostTimeNs();
+    for (long i = 0; i < iterations; i++) {
+        angle_t angle = (angle_t)(i * 182);
+        sink += fix16ToInt(fix16MulInt(angleCos(angle), 16));
+        sink += fix16ToInt(fix16MulInt(angleSin(angle), 16));
+    }
+    uint64_t tableNs = hostTimeNs() - start;
+
+    double maxError = 0;
+    for (uint32_t a = 0; a < 65536; a++) {
+        double radians = a * (2 * M_PI / 65536);
+        double errSin = fabs(fix16ToFloat(angleSin((angle_t)a)) - sin(radians));
+        double errCos = fabs(fix16ToFloat(angleCos((angle_t)a)) - cos(radians));
+        if (errSin > maxError) {
+            maxError = errSin;
+        }
+        if (errCos > maxError) {
+            maxError = errCos;
+        }
+    }
+
+    printf("iterations        %ld\n", iterations);
+    printf("libm  cos+sin     %.2f ns\n", (double)libmNs / iterations);
+    printf("table cos+sin     %.2f ns\n", (double)tableNs / iterations);
+    printf("speedup           %.1fx\n", (double)libmNs / tableNs);
+    printf("max table error   %.2e\n", maxError);
+    return 0;
+}
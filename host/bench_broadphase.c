@@ -0,0 +1,124 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host benchmark: grid broadphase vs brute force shot/satchel checks
+ *******************************************************************************
+ * Builds with PHYSICS_MAX_OBJECTS large enough for the biggest scene. Each
+ * simulated tick moves every object, keeps the grid current and runs the
+ * interception query for every shot, plus one shield query at the platform.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "broadphase.h"
+#include "host_timer.h"
+
+#define TICKS 2000
+
+static struct physicsData objects[PHYSICS_MAX_OBJECTS];
+static struct broadphase grid;
+
+static void scatter(int count)
+{
+    srand(1);
+    for (int i = 0; i < PHYSICS_MAX_OBJECTS; i++) {
+        objects[i].objectType = empty;
+    }
+    for (int i = 0; i < count; i++) {
+        objects[i].objectType = (i & 1) ? satchel : shot;
+        objects[i].x = fix16FromInt(rand() % BROADPHASE_WORLD_SIZE);
+        objects[i].y = fix16FromInt(rand() % BROADPHASE_WORLD_SIZE);
+        objects[i].xVel = (rand() % 65536) - 32768; // up to half a unit per tick
+        objects[i].yVel = (rand() % 65536) - 32768;
+    }
+}
+
+static void move(int count)
+{
+    const fix16_t limit = FIX16_FROM_INT(BROADPHASE_WORLD_SIZE);
+    for (int i = 0; i < count; i++) {
+        objects[i].x += objects[i].xVel;
+        objects[i].y += objects[i].yVel;
+        if (objects[i].x < 0 || objects[i].x >= limit) {
+            objects[i].xVel = -objects[i].xVel;
+        }
+        if (objects[i].y < 0 || objects[i].y >= limit) {
+            objects[i].yVel = -objects[i].yVel;
+        }
+    }
+}
+
+static uint64_t runGrid(int count, long *hits)
+{
+    const fix16_t intercept = FIX16_FROM_INT(8);
+    const fix16_t shield = FIX16_FROM_INT(20);
+    const fix16_t center = FIX16_FROM_INT(BROADPHASE_WORLD_SIZE / 2);
+    scatter(count);
+    bpInit(&grid, objects);
+    uint64_t start = hostTimeNs();
+    for (int t = 0; t < TICKS; t++) {
+        move(count);
+        for (int i = 0; i < count; i++) {
+            bpUpdate(&grid, (poolIndex_t)i);
+        }
+        for (int i = 0; i < count; i++) {
+            if (objects[i].objectType == shot &&
+                bpFindNearby(&grid, objects[i].x, objects[i].y, intercept, satchel) != POOL_NONE) {
+                (*hits)++;
+            }
+        }
+        if (bpFindNearby(&grid, center, 0, shield, satchel) != POOL_NONE) {
+            (*hits)++;
+        }
+    }
+    return hostTimeNs() - start;
+}
+
+static uint64_t runBrute(int count, long *hits)
+{
+    const fix16_t intercept = FIX16_FROM_INT(8);
+    const fix16_t shield = FIX16_FROM_INT(20);
+    const fix16_t center = FIX16_FROM_INT(BROADPHASE_WORLD_SIZE / 2);
+    scatter(count);
+    uint64_t start = hostTimeNs();
+    for (int t = 0; t < TICKS; t++) {
+        move(count);
+        for (int i = 0; i < count; i++) {
+            if (objects[i].objectType != shot) {
+                continue;
+            }
+            for (int j = 0; j < count; j++) {
+                if (objects[j].objectType == satchel &&
+                    fix16WithinRange(objects[i].x, objects[i].y, objects[j].x, objects[j].y, intercept)) {
+                    (*hits)++;
+                    break;
+                }
+            }
+        }
+        for (int j = 0; j < count; j++) {
+            if (objects[j].objectType == satchel && fix16WithinRange(center, 0, objects[j].x, objects[j].y, shield)) {
+                (*hits)++;
+                break;
+            }
+        }
+    }
+    return hostTimeNs() - start;
+}
+
+int main(void)
+{
+    static const int sizes[] = {10, 100, 1000};
+    printf("%8s %14s %14s %8s\n", "objects", "grid ns/tick", "brute ns/tick", "hits");
+    for (unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int count = sizes[s];
+        if (count > PHYSICS_MAX_OBJECTS) {
+            break;
+        }
+        long gridHits = 0;
+        long bruteHits = 0;
+        uint64_t gridNs = runGrid(count, &gridHits);
+        uint64_t bruteNs = runBrute(count, &bruteHits);
+        printf("%8d %14.0f %14.0f %8s\n", count, (double)gridNs / TICKS, (double)bruteNs / TICKS,
+               gridHits == bruteHits ? "match" : "DIFFER");
+    }
+    return 0;
+}
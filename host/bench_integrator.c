@@ -0,0 +1,217 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host benchmark: shot integrators against the analytic trajectory
+ *******************************************************************************
+ * Flies a fan of railgun shots (every aim, every charge) with each integrator
+ * at several physics periods and compares them with the closed-form path:
+ *
+ *   euler     explicit Euler, position from the old velocity
+ *   semi      semi-implicit Euler, the shot loop before substeps
+ *   verlet    velocity Verlet, one step per tick
+ *   adaptive  velocity Verlet with the per-shot substeps physicsStep() uses
+ *
+ * Errors are the worst distance from the exact position at any sampled
+ * position (tick ends, or substep ends for adaptive), and the distance between where a shot is first seen past the ground or the wall and
+ * where it really crossed. "missed" is the share of satchels placed on the
+ * exact path that no sampled position comes within interceptRange of. Cost
+ * is per shot per simulated second, so a longer period shows its saving.
+ ******************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "fixedpoint.h"
+#include "angle.h"
+#include "game.h"
+#include "host_timer.h"
+
+#define START_X          100 // px, about where the platform sits
+#define START_Y          1
+#define MAX_SPEED        100 // px/s at full charge
+#define INTERCEPT_RANGE  8 // shotRadius + satchel radius of the Normal profile
+#define FLIGHT_LIMIT_S   30
+#define MAX_SAMPLES      4096
+
+enum method {methodEuler, methodSemi, methodVerlet, methodAdaptive, METHOD_COUNT};
+static const char *const methodNames[METHOD_COUNT] = {"euler", "semi", "verlet", "adaptive"};
+
+struct shotResult {
+    int ticks;
+    int substeps;
+    int sampleCount;
+    struct {
+        fix16_t x, y, t;
+    } samples[MAX_SAMPLES]; // every position the collision checks would see
+};
+
+static volatile uint32_t sink;
+
+static void exactAt(double vx, double vy, double t, double *x, double *y)
+{
+    *x = START_X + vx * t;
+    *y = START_Y + vy * t + GRAVITY * t * t / 2;
+}
+
+// Exact time the shot reaches y = 0 or x = 0, whichever is first
+static double exactCrossTime(double vx, double vy)
+{
+    double tGround = (-vy - sqrt(vy * vy - 2.0 * GRAVITY * START_Y)) / GRAVITY;
+    double tWall = vx < 0 ? -START_X / vx : INFINITY;
+    return tGround < tWall ? tGround : tWall;
+}
+
+static void sample(struct shotResult *r, fix16_t x, fix16_t y, fix16_t t)
+{
+    if (r->sampleCount < MAX_SAMPLES) {
+        r->samples[r->sampleCount].x = x;
+        r->samples[r->sampleCount].y = y;
+        r->samples[r->sampleCount++].t = t;
+    }
+}
+
+static void fly(enum method m, fix16_t xVel, fix16_t yVel, fix16_t dt, bool record, struct shotResult *r)
+{
+    fix16_t x = fix16FromInt(START_X), y = fix16FromInt(START_Y), t = 0;
+    const fix16_t g = fix16FromInt(GRAVITY);
+    const fix16_t range = fix16FromInt(INTERCEPT_RANGE);
+    int maxTicks = FLIGHT_LIMIT_S * FIX16_ONE / dt;
+    r->ticks = 0;
+    r->substeps = 0;
+    r->sampleCount = 0;
+    while (x > 0 && y > 0 && r->ticks < maxTicks) {
+        r->ticks++;
+        switch (m) {
+          case methodEuler:
+              x = fix16Step(x, xVel, dt);
+              y = fix16Step(y, yVel, dt);
+              yVel = fix16Step(yVel, g, dt);
+              r->substeps++;
+              break;
+          case methodSemi:
+              yVel = fix16Step(yVel, g, dt);
+              x = fix16Step(x, xVel, dt);
+              y = fix16Step(y, yVel, dt);
+              r->substeps++;
+              break;
+          case methodVerlet:
+              x = fix16VerletStep(x, xVel, 0, dt);
+              y = fix16VerletStep(y, yVel, g, dt);
+              yVel = fix16Step(yVel, g, dt);
+              r->substeps++;
+              break;
+          default: {
+              int shift = fix16SubstepShift(xVel, yVel, dt, range, SHOT_MAX_SUBSTEP_SHIFT);
+              fix16_t h = dt >> shift;
+              for (int n = 1 << shift; n > 0 && x > 0 && y > 0; n--) {
+                  if (n == 1) {
+                      h = dt - (h << shift) + h;
+                  }
+                  x = fix16VerletStep(x, xVel, 0, h);
+                  y = fix16VerletStep(y, yVel, g, h);
+                  yVel = fix16Step(yVel, g, h);
+                  t += h;
+                  r->substeps++;
+                  if (record) {
+                      sample(r, x, y, t);
+                  }
+              }
+              break;
+          }
+        }
+        if (m != methodAdaptive) {
+            t += dt;
+            if (record) {
+                sample(r, x, y, t);
+            }
+        }
+    }
+    sink += (uint32_t)x + (uint32_t)y;
+}
+
+// Worst error of any sampled position, and of the first one past the ground or wall
+static void measure(double vx, double vy, const struct shotResult *r, double *maxError, double *crossError)
+{
+    *maxError = 0;
+    for (int i = 0; i < r->sampleCount; i++) {
+        double x, y;
+        exactAt(vx, vy, fix16ToFloat(r->samples[i].t), &x, &y);
+        double e = hypot(fix16ToFloat(r->samples[i].x) - x, fix16ToFloat(r->samples[i].y) - y);
+        *maxError = e > *maxError ? e : *maxError;
+    }
+    double cx, cy;
+    exactAt(vx, vy, exactCrossTime(vx, vy), &cx, &cy);
+    *crossError = hypot(fix16ToFloat(r->samples[r->sampleCount - 1].x) - cx,
+                        fix16ToFloat(r->samples[r->sampleCount - 1].y) - cy);
+}
+
+// Share of satchels on the exact path that no sample comes within interceptRange of
+static double missedIntercepts(double vx, double vy, const struct shotResult *r)
+{
+    const int satchels = 64;
+    double cross = exactCrossTime(vx, vy);
+    int missed = 0;
+    for (int k = 0; k < satchels; k++) {
+        double sx, sy;
+        exactAt(vx, vy, cross * (k + 0.5) / satchels, &sx, &sy);
+        fix16_t fx = (fix16_t)(sx * FIX16_ONE), fy = (fix16_t)(sy * FIX16_ONE);
+        bool seen = false;
+        for (int i = 0; i < r->sampleCount && !seen; i++) {
+            seen = fix16WithinRange(fx, fy, r->samples[i].x, r->samples[i].y, fix16FromInt(INTERCEPT_RANGE));
+        }
+        missed += !seen;
+    }
+    return (double)missed / satchels;
+}
+
+int main(int argc, char **argv)
+{
+    static const int periodsMs[] = {50, 100, 200};
+    int repeats = argc > 1 ? atoi(argv[1]) : 20;
+    static struct shotResult result;
+
+    printf("%-6s %-9s %10s %10s %8s %10s %12s\n",
+           "period", "method", "max err px", "cross px", "missed", "substeps", "ns/shot-s");
+    for (unsigned p = 0; p < sizeof(periodsMs) / sizeof(periodsMs[0]); p++) {
+        fix16_t dt = fix16FromFrac(periodsMs[p], 1000);
+        for (int m = 0; m < METHOD_COUNT; m++) {
+            double maxError = 0, crossError = 0, missed = 0;
+            uint64_t ticks = 0, substeps = 0, shots = 0;
+            // Accuracy over the fan of shots: aim 95..175 degrees (toward the castle), 20..100% charge
+            for (int deg = 95; deg <= 175; deg += 5) {
+                for (int pct = 20; pct <= 100; pct += 10) {
+                    angle_t aim = angleFromDegrees(deg);
+                    fix16_t speed = fix16MulInt(fix16FromFrac(pct, 100), MAX_SPEED);
+                    fix16_t xVel = fix16Mul(speed, angleCos(aim));
+                    fix16_t yVel = fix16Mul(speed, angleSin(aim));
+                    double vx = fix16ToFloat(xVel), vy = fix16ToFloat(yVel);
+                    double e, c;
+                    fly((enum method)m, xVel, yVel, dt, true, &result);
+                    measure(vx, vy, &result, &e, &c);
+                    maxError = e > maxError ? e : maxError;
+                    crossError = c > crossError ? c : crossError;
+                    missed += missedIntercepts(vx, vy, &result);
+                    ticks += result.ticks;
+                    substeps += result.substeps;
+                    shots++;
+                }
+            }
+            // Cost: the same fan again without recording, timed
+            uint64_t start = hostTimeNs();
+            for (int rep = 0; rep < repeats; rep++) {
+                for (int deg = 95; deg <= 175; deg += 5) {
+                    for (int pct = 20; pct <= 100; pct += 10) {
+                        angle_t aim = angleFromDegrees(deg);
+                        fix16_t speed = fix16MulInt(fix16FromFrac(pct, 100), MAX_SPEED);
+                        fly((enum method)m, fix16Mul(speed, angleCos(aim)), fix16Mul(speed, angleSin(aim)), dt,
+                            false, &result);
+                    }
+                }
+            }
+            double ns = (double)(hostTimeNs() - start) / repeats;
+            double simS = (double)ticks * periodsMs[p] / 1000.0;
+            printf("%4dms %-9s %10.3f %10.3f %7.1f%% %10.2f %12.1f\n", periodsMs[p], methodNames[m],
+                   maxError, crossError, 100.0 * missed / shots, (double)substeps / ticks, ns / simS);
+        }
+    }
+    return 0;
+}
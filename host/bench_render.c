@@ -0,0 +1,208 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host benchmark: the display task's rendering, per scene
+ *******************************************************************************
+ * Draws representative screens with render.c over the host GLIB/DMD of
+ * glib_host.c and reports nanoseconds per frame: the drawing alone, and with
+ * the dirty-line diff of lcdlines.c that follows it on the target. Game
+ * screens are drawn both with the cached background layer and redrawing it
+ * every frame. Moving scenes shift their objects every frame, so the diff
+ * always has lines to send. The hud scenes add the performance HUD with a
+ * new sample every HUD_SAMPLE_FRAMES frames, as at 20 fps. Each figure is
+ * the best of a few runs.
+ *
+ *   ./bench_render [-n frames] [-d dir] [-c dir]
+ *
+ *   -d dir  writes each scene's first frame to dir/<scene>.pbm
+ *   -c dir  compares each scene's first frame with dir/<scene>.pbm and exits
+ *           non-zero on any difference, for golden-image checks
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "dmd.h"
+#include "glib.h"
+#include "glib_host.h"
+#include "lcdlines.h"
+#include "profiles.h"
+#include "render.h"
+#include "host_timer.h"
+
+struct scene {
+    const char *name;
+    int state;
+    int satchels;
+    int shots;
+    bool moving;
+    bool hud;
+};
+
+static const struct scene scenes[] = {
+    {"menu", menu, 0, 0, false, false},
+    {"gameover", win, 0, 0, false, false},
+    {"idle", active, 0, 0, false, false},
+    {"play", active, 1, 1, true, false},
+    {"busy", active, 2, 6, true, false},
+    {"hudmenu", menu, 0, 0, false, true},
+    {"hudplay", active, 1, 1, true, true},
+};
+#define SCENE_COUNT (int)(sizeof(scenes) / sizeof(scenes[0]))
+
+#define SCENE_FRAMES 40 // a moving scene's objects come back to where they started
+#define RUNS         5
+#define HUD_SAMPLE_FRAMES 10 // PERF_HUD_PERIOD at 20 fps
+
+static GLIB_Context_t glib;
+static struct renderer renderer;
+static struct gameFrame frames[SCENE_FRAMES];
+static struct lcdLines lines;
+static uint8_t command[LCD_UPDATE_MAX_BYTES];
+static volatile uint32_t hashSink; // keeps the hash loop from being optimized away
+static struct perfHudSample hud;
+
+// A HUD sample as on the target, varied by n so each one draws differently
+static void buildHud(int n)
+{
+    static const char *const names[PERF_HUD_TASKS] = {"phys", "lcd", "btn", "sldr", "led0", "led1"};
+    hud.cpu = (uint16_t)(1234 + 37 * n);
+    hud.rate = 30;
+    hud.stepMicros = 145 + (uint32_t)n % 20;
+    hud.frameMicros = 812 + (uint32_t)n % 50;
+    hud.tasks = PERF_HUD_TASKS;
+    for (int i = 0; i < PERF_HUD_TASKS; i++) {
+        hud.task[i].name = names[i];
+        hud.task[i].cpu = (uint16_t)(100 * i + n % 100);
+        hud.task[i].stackFree = 200u - 10u * (uint32_t)i;
+    }
+}
+
+// The scene as the display task would see it, frame by frame
+static void buildFrames(const struct scene *s, const struct physicsConstants *consts)
+{
+    memset(frames, 0, sizeof(frames));
+    for (int n = 0; n < SCENE_FRAMES; n++) {
+        struct gameFrame *frame = &frames[n];
+        frame->game.state = s->state;
+        frame->game.profile = profileNormal;
+        frame->game.evacComplete = true;
+        frame->game.energy = consts->generatorConst.energyCapacity * JOULES_PER_KJ * 3 / 5;
+        frame->game.foundationDamage = 1;
+        int shift = s->moving ? n : 0;
+        frame->objects[0].objectType = player;
+        frame->objects[0].x = fix16FromInt(60 + shift / 2);
+        int slot = 1;
+        for (int i = 0; i < s->satchels; i++, slot++) {
+            frame->objects[slot].objectType = satchel;
+            frame->objects[slot].x = fix16FromInt(30 + 25 * i + shift);
+            frame->objects[slot].y = fix16FromInt(90 - 10 * i - shift);
+        }
+        for (int i = 0; i < s->shots; i++, slot++) {
+            frame->objects[slot].objectType = shot;
+            frame->objects[slot].x = fix16FromInt(50 + 9 * i - shift);
+            frame->objects[slot].y = fix16FromInt(20 + 12 * i + shift);
+        }
+    }
+}
+
+// Best time per frame over RUNS runs of count frames
+static double timeScene(struct renderScene *rs, int count, bool draw, bool diff)
+{
+    double best = 0;
+    for (int run = 0; run < RUNS; run++) {
+        uint32_t sum = 0;
+        uint64_t start = hostTimeNs();
+        for (int n = 0; n < count; n++) {
+            rs->frame = &frames[n % SCENE_FRAMES];
+            if (rs->hud && n % HUD_SAMPLE_FRAMES == 0) {
+                buildHud(n / HUD_SAMPLE_FRAMES);
+                rs->hudVersion++;
+            }
+            if (draw) {
+                renderDraw(&renderer, rs);
+            } else {
+                sum += renderHash(&renderer, rs);
+            }
+            if (diff) {
+                sum += (uint32_t)lcdLinesUpdate(&lines, renderer.framebuffer, command);
+            }
+        }
+        double ns = (double)(hostTimeNs() - start) / count;
+        best = run == 0 || ns < best ? ns : best;
+        hashSink += sum;
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    int count = 20000;
+    const char *dumpDir = NULL, *compareDir = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:d:c:")) != -1) {
+        if (opt == 'n') {
+            count = atoi(optarg) > 0 ? atoi(optarg) : 1;
+        } else if (opt == 'd') {
+            dumpDir = optarg;
+        } else if (opt == 'c') {
+            compareDir = optarg;
+        } else {
+            fprintf(stderr, "usage: %s [-n frames] [-d dir] [-c dir]\n", argv[0]);
+            return 2;
+        }
+    }
+    void *framebuffer;
+    DMD_init(0);
+    DMD_getFrameBuffer(&framebuffer);
+    GLIB_contextInit(&glib);
+    glib.backgroundColor = White;
+    glib.foregroundColor = Black;
+    GLIB_setFont(&glib, (GLIB_Font_t *)&GLIB_FontNormal8x8);
+    const struct physicsConstants *consts = &physicsProfiles[profileNormal].consts;
+    struct renderScene rs = {.frame = &frames[0], .consts = consts, .aim = angleFromDegrees(consts->railGunConst.railgunAngle),
+                             .aimVersion = 1};
+    int mismatches = 0;
+    printf("%-9s %-6s %12s %14s %10s\n", "scene", "layer", "render ns", "+lines ns", "hash ns");
+    for (int i = 0; i < SCENE_COUNT; i++) {
+        const struct scene *s = &scenes[i];
+        renderInit(&renderer, &glib, framebuffer, true);
+        buildFrames(s, consts);
+        rs.frame = &frames[0];
+        rs.hud = s->hud ? &hud : NULL;
+        rs.hudVersion = 1;
+        buildHud(0);
+        renderDraw(&renderer, &rs);
+        DMD_updateDisplay();
+        char path[512];
+        if (dumpDir) {
+            snprintf(path, sizeof(path), "%s/%s.pbm", dumpDir, s->name);
+            if (!hostWritePbm(path, hostPanel)) {
+                fprintf(stderr, "cannot write %s\n", path);
+                return 1;
+            }
+        }
+        if (compareDir) {
+            static uint32_t golden[FRAMEBUF_WORDS];
+            snprintf(path, sizeof(path), "%s/%s.pbm", compareDir, s->name);
+            if (!hostReadPbm(path, golden)) {
+                fprintf(stderr, "cannot read %s\n", path);
+                return 1;
+            }
+            if (memcmp(golden, hostPanel, sizeof(golden)) != 0) {
+                fprintf(stderr, "%s differs from %s\n", s->name, path);
+                mismatches++;
+            }
+        }
+        double hashNs = timeScene(&rs, count, false, false);
+        for (int layer = 1; layer >= (s->state == active ? 0 : 1); layer--) {
+            renderInit(&renderer, &glib, framebuffer, layer);
+            lcdLinesInit(&lines);
+            double renderNs = timeScene(&rs, count, true, false);
+            double linesNs = timeScene(&rs, count, true, true);
+            printf("%-9s %-6s %12.0f %14.0f %10.1f\n", s->name, s->state != active ? "-" : layer ? "cached" : "drawn",
+                   renderNs, linesNs, hashNs);
+        }
+    }
+    return mismatches != 0;
+}
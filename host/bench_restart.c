@@ -0,0 +1,71 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host benchmark: in-place restart to the first published frame
+ *******************************************************************************
+ * Times what the physics task does between BTN0 on the game over screen and
+ * the first frame of the next game: gameInitProfile(), recorderBegin(),
+ * gamePrepareFrame() and snapshotPublish(). Each round first plays a few
+ * hundred steps so the pool, grid and event queue hold a finished game's
+ * leftovers, as they do on the target.
+ *
+ *   ./bench_restart [rounds]
+ *
+ * The target's own figure is the phaseRestart histogram of cycleprof.h.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "game.h"
+#include "recorder.h"
+#include "snapshot.h"
+#include "host_timer.h"
+
+#define PLAY_STEPS 600 // 30 s at the Normal profile's 50 ms step
+
+static struct gameState state;
+static struct recorder rec;
+static struct frameSnapshot snapshot;
+
+// Fire and move constantly so the game ends with objects in flight
+static void play(uint32_t steps)
+{
+    struct gameInputs inputs = {0};
+    for (uint32_t i = 0; i < steps && state.game.state == active; i++) {
+        inputs.left = i / 20 % 4 == 0;
+        inputs.right = i / 20 % 4 == 2;
+        inputs.charge = i % 8 < 6;
+        inputs.aim = angleFromDegrees(100 + (int)(i % 60));
+        physicsStep(&state, &inputs, state.step.dt);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int rounds = argc > 1 ? atoi(argv[1]) : 2000;
+    if (rounds < 1) {
+        rounds = 1;
+    }
+    uint64_t totalNs = 0, maxNs = 0;
+    snapshotInit(&snapshot);
+    recorderInit(&rec);
+    for (int p = 0; p < PHYSICS_PROFILE_COUNT; p++) {
+        totalNs = 0;
+        maxNs = 0;
+        for (int r = 0; r < rounds; r++) {
+            uint32_t seed = 1 + (uint32_t)r;
+            gameInitProfile(&state, p, seed);
+            play(PLAY_STEPS);
+            uint64_t start = hostTimeNs();
+            gameInitProfile(&state, p, seed + 1);
+            recorderBegin(&rec, seed + 1, state.consts);
+            gamePrepareFrame(&state);
+            snapshotPublish(&snapshot, state.objects, state.previous, &state.game, 0, 1);
+            uint64_t ns = hostTimeNs() - start;
+            totalNs += ns;
+            maxNs = ns > maxNs ? ns : maxNs;
+        }
+        printf("%-22s restart mean %7.2f us  max %7.2f us  (%d rounds)\n", physicsProfiles[p].name,
+               totalNs / 1000.0 / rounds, maxNs / 1000.0, rounds);
+    }
+    return 0;
+}
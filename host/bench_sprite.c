@@ -0,0 +1,148 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host benchmark: sprite blits vs GLIB's filled circle and lines
+ *******************************************************************************
+ * Draws satchels, shots and the railgun barrel both ways at the Normal
+ * profile's sizes. The GLIB side is the host GLIB of glib_host.c, which
+ * draws as the SDK's does over the memory LCD DMD: midpoint spans and
+ * Bresenham lines, one DMD pixel write at a time.
+ * First every position from fully off the left/top edge to fully off the
+ * right/bottom one is drawn both ways and the frames compared, which checks
+ * the shapes and the clipping; then each is timed per object.
+ *
+ *   ./bench_sprite [objects]
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dmd.h"
+#include "framebuf.h"
+#include "glib.h"
+#include "sprite.h"
+#include "host_timer.h"
+
+#define SATCHEL_RADIUS 3 // satchelDisplayDiameter 7 / 2
+#define SHOT_RADIUS    5
+#define CANNON_LENGTH  16 // platformLength
+
+static uint32_t frameA[FRAMEBUF_WORDS];
+static uint32_t *frameB; // the DMD framebuffer GLIB draws into
+static GLIB_Context_t glib;
+
+// The display task's barrel: four lines from the base at (x, y) to (x + dx, y + dy)
+static void glibCannon(int x, int y, int dx, int dy)
+{
+    for (int i = -1; i < 3; i++) {
+        GLIB_drawLine(&glib, x + dx + i, y + dy, x + i, y);
+    }
+}
+
+// As buildCannon() in render.c
+static void buildCannon(struct sprite *sprite, int dx, int dy)
+{
+    int left = (dx < 0 ? dx : 0) - 1;
+    int top = dy < 0 ? dy : 0;
+    spriteEmpty(sprite, abs(dx) + 4, abs(dy) + 1, -left, -top);
+    for (int i = -1; i < 3; i++) {
+        spriteLine(sprite, dx + i, dy, i, 0);
+    }
+}
+
+// Every barrel end point at CANNON_LENGTH, each at a spread of positions including the edges
+static int checkCannons(void)
+{
+    int mismatches = 0;
+    struct sprite sprite;
+    for (int dy = -CANNON_LENGTH; dy <= CANNON_LENGTH; dy++) {
+        for (int dx = -CANNON_LENGTH; dx <= CANNON_LENGTH; dx++) {
+            buildCannon(&sprite, dx, dy);
+            for (int y = -CANNON_LENGTH - 1; y <= LCD_HEIGHT + CANNON_LENGTH; y += 7) {
+                for (int x = -CANNON_LENGTH - 3; x <= LCD_WIDTH + CANNON_LENGTH + 1; x += 5) {
+                    memset(frameA, 0xff, sizeof(frameA));
+                    memset(frameB, 0xff, sizeof(frameA));
+                    spriteBlit(frameA, &sprite, x, y);
+                    glibCannon(x, y, dx, dy);
+                    mismatches += memcmp(frameA, frameB, sizeof(frameA)) != 0;
+                }
+            }
+        }
+    }
+    return mismatches;
+}
+
+static int checkShapes(const struct sprite *sprite, int radius)
+{
+    int mismatches = 0;
+    for (int y = -radius - 1; y <= LCD_HEIGHT + radius; y++) {
+        for (int x = -radius - 1; x <= LCD_WIDTH + radius; x++) {
+            memset(frameA, 0xff, sizeof(frameA));
+            memset(frameB, 0xff, sizeof(frameA));
+            spriteBlit(frameA, sprite, x, y);
+            GLIB_drawCircleFilled(&glib, x, y, radius);
+            mismatches += memcmp(frameA, frameB, sizeof(frameA)) != 0;
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char **argv)
+{
+    int objects = argc > 1 ? atoi(argv[1]) : 200000;
+    DMD_init(0);
+    DMD_getFrameBuffer((void **)&frameB);
+    GLIB_contextInit(&glib);
+    static const int radii[] = {SATCHEL_RADIUS, SHOT_RADIUS};
+    static const char *const names[] = {"satchel", "shot"};
+    int *xs = malloc(sizeof(int) * objects), *ys = malloc(sizeof(int) * objects);
+    srand(1);
+    for (int i = 0; i < objects; i++) {
+        xs[i] = rand() % (LCD_WIDTH + 8) - 4; // a few land on the edges
+        ys[i] = rand() % (LCD_HEIGHT + 8) - 4;
+    }
+    printf("%-8s %6s %10s %12s %12s %8s\n", "object", "radius", "mismatch", "blit ns", "glib ns", "speedup");
+    for (int k = 0; k < 2; k++) {
+        struct sprite sprite;
+        spriteCircle(&sprite, radii[k]);
+        int mismatches = checkShapes(&sprite, radii[k]);
+        memset(frameA, 0xff, sizeof(frameA));
+        uint64_t start = hostTimeNs();
+        for (int i = 0; i < objects; i++) {
+            spriteBlit(frameA, &sprite, xs[i], ys[i]);
+        }
+        double blitNs = (double)(hostTimeNs() - start) / objects;
+        memset(frameB, 0xff, sizeof(frameA));
+        start = hostTimeNs();
+        for (int i = 0; i < objects; i++) {
+            GLIB_drawCircleFilled(&glib, xs[i], ys[i], radii[k]);
+        }
+        double glibNs = (double)(hostTimeNs() - start) / objects;
+        mismatches += memcmp(frameA, frameB, sizeof(frameA)) != 0;
+        printf("%-8s %6d %10d %12.1f %12.1f %7.1fx\n", names[k], radii[k], mismatches, blitNs, glibNs, glibNs / blitNs);
+        if (mismatches) {
+            return 1;
+        }
+    }
+    // The barrel at the default 135 degree aim
+    struct sprite cannon;
+    int dx = -CANNON_LENGTH * 7071 / 10000, dy = CANNON_LENGTH * 7071 / 10000;
+    buildCannon(&cannon, dx, dy);
+    int mismatches = checkCannons();
+    memset(frameA, 0xff, sizeof(frameA));
+    uint64_t start = hostTimeNs();
+    for (int i = 0; i < objects; i++) {
+        spriteBlit(frameA, &cannon, xs[i], ys[i]);
+    }
+    double blitNs = (double)(hostTimeNs() - start) / objects;
+    memset(frameB, 0xff, sizeof(frameA));
+    start = hostTimeNs();
+    for (int i = 0; i < objects; i++) {
+        glibCannon(xs[i], ys[i], dx, dy);
+    }
+    double glibNs = (double)(hostTimeNs() - start) / objects;
+    mismatches += memcmp(frameA, frameB, sizeof(frameA)) != 0;
+    printf("%-8s %6d %10d %12.1f %12.1f %7.1fx\n", "cannon", CANNON_LENGTH, mismatches, blitNs, glibNs, glibNs / blitNs);
+    free(xs);
+    free(ys);
+    return mismatches != 0;
+}
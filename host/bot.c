@@ -0,0 +1,105 @@
+/***************************************************************************//**
+ * @file
+ * @brief Scripted players for the host tools
+ *******************************************************************************
+ *   idle    never touches anything
+ *   random  mashes the slider and buttons, with human-ish hold times
+ *   defend  shields the satchel overhead, steps away from it when the shield
+ *           is not charged and otherwise keeps firing full charges
+ ******************************************************************************/
+
+#include <string.h>
+#include "bot.h"
+
+static uint32_t botRandom32(struct bot *bot)
+{
+    uint32_t x = bot->random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    bot->random = x;
+    return x;
+}
+
+bool botPolicyFromName(const char *name, enum botPolicy *policy)
+{
+    static const char *const names[] = {"idle", "random", "defend"};
+    for (int i = 0; i < 3; i++) {
+        if (!strcmp(name, names[i])) {
+            *policy = (enum botPolicy)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+void botInit(struct bot *bot, enum botPolicy policy, uint32_t seed, angle_t baseAim)
+{
+    memset(bot, 0, sizeof(*bot));
+    bot->policy = policy;
+    bot->baseAim = baseAim;
+    bot->aim = baseAim;
+    bot->random = seed * 2654435761u + 1;
+}
+
+static void randomInputs(struct bot *bot, struct gameInputs *in)
+{
+    if (bot->sliderHold-- <= 0) {
+        bot->slider = botRandom32(bot) % 5;
+        bot->sliderHold = botRandom32(bot) % 10 + 1;
+        bot->aim = bot->baseAim + (angle_t)(botRandom32(bot) % ANGLE_FROM_DEGREES(40)) - ANGLE_FROM_DEGREES(20);
+    }
+    in->farLeft = bot->slider == 1;
+    in->left = bot->slider == 2;
+    in->right = bot->slider == 3;
+    in->farRight = bot->slider == 4;
+    if (bot->chargeHold == 0) {
+        bot->chargeHold = (botRandom32(bot) & 1) ? (int)(botRandom32(bot) % 40) + 1
+                                                 : -(int)(botRandom32(bot) % 20) - 1;
+    }
+    in->charge = bot->chargeHold > 0;
+    bot->chargeHold += bot->chargeHold > 0 ? -1 : 1;
+    in->shield = botRandom32(bot) % 50 == 0;
+}
+
+static void defendInputs(struct gameState *state, struct gameInputs *in)
+{
+    gamePrepareFrame(state);
+    const struct physicsData *player = &state->objects[0];
+    fix16_t range = state->step.shieldRange;
+    poolIndex_t lowest = POOL_NONE;
+    for (poolIndex_t i = poolFirst(&state->pool, satchel); i != POOL_NONE; i = poolNext(&state->pool, i)) {
+        if (lowest == POOL_NONE || state->objects[i].y < state->objects[lowest].y) {
+            lowest = i;
+        }
+    }
+    bool threat = false;
+    if (lowest != POOL_NONE) {
+        const struct physicsData *s = &state->objects[lowest];
+        bool shieldReady = state->game.energy >= state->step.shieldEnergy;
+        threat = s->y < range * 3;
+        if (fix16WithinRange(player->x, player->y, s->x, s->y, range)) {
+            in->shield = shieldReady;
+        } else if (!shieldReady && threat && fix16Abs(s->x - player->x) < range) {
+            in->farLeft = s->x >= player->x;
+            in->farRight = s->x < player->x;
+        }
+    }
+    // Keep energy for the shield while a satchel is coming down
+    in->charge = !threat && state->game.shotCharge < state->step.maxShotCharge;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Inputs for the next physicsStep() of state.
+ ******************************************************************************/
+void botInputs(struct bot *bot, struct gameState *state, struct gameInputs *in)
+{
+    memset(in, 0, sizeof(*in));
+    if (bot->policy == botRandom) {
+        randomInputs(bot, in);
+    } else if (bot->policy == botDefend) {
+        defendInputs(state, in);
+    }
+    in->aim = bot->aim;
+}
@@ -0,0 +1,28 @@
+/***************************************************************************//**
+ * @file
+ * @brief Scripted players for the host tools
+ ******************************************************************************/
+
+#ifndef BOT_H
+#define BOT_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+
+enum botPolicy {botIdle, botRandom, botDefend};
+
+struct bot {
+    enum botPolicy policy;
+    angle_t baseAim;
+    angle_t aim;
+    uint32_t random;
+    int sliderHold; // ticks left on the current slider choice
+    int slider; // 0 none, 1 farLeft, 2 left, 3 right, 4 farRight
+    int chargeHold; // ticks left holding (positive) or released (negative)
+};
+
+bool botPolicyFromName(const char *name, enum botPolicy *policy);
+void botInit(struct bot *bot, enum botPolicy policy, uint32_t seed, angle_t baseAim);
+void botInputs(struct bot *bot, struct gameState *state, struct gameInputs *in);
+
+#endif // BOT_H
@@ -0,0 +1,20 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host stand-in for the Gecko SDK's DMD, memory LCD flavour
+ *******************************************************************************
+ * One 128x128 1bpp framebuffer in the memory LCD DMD's layout (framebuf.h):
+ * LSB first, a set bit white. DMD_updateDisplay() copies it to the host
+ * panel of glib_host.h instead of sending it.
+ ******************************************************************************/
+
+#ifndef DMD_H
+#define DMD_H
+#include "glib.h"
+
+#define DMD_OK 0
+
+EMSTATUS DMD_init(void *param);
+EMSTATUS DMD_getFrameBuffer(void **framebuffer);
+EMSTATUS DMD_updateDisplay(void);
+
+#endif // DMD_H
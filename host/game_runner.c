@@ -0,0 +1,263 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host batch runner: plays many headless games through physicsStep()
+ *******************************************************************************
+ * Links against libgame.a, the same engine the physics task runs. Each game
+ * uses seed + game number, so any game in a batch can be replayed alone.
+ *
+ *   ./game_runner [-n games] [-s seed] [-p idle|random|defend] [-t max seconds]
+ *                 [-P profile] [-o record file] [-v]
+ *
+ * Reports games/sec, per tick latency percentiles of physicsStep() and the
+ * outcome statistics of the batch. Steps gameQuietSteps() reports as idle are
+ * fast-forwarded as on the target and counted. Every game goes through the
+ * input recorder; -o writes the first game's record for ./replay and -v
+ * replays every record and checks it reproduces the game's outcome. Games
+ * start from the compile time profile table and replay, step by step, from
+ * the recorded constants, so -v also checks that fast-forwarding and the
+ * table give the same game as plain steps from loose constants.
+ ******************************************************************************/
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "game.h"
+#include "recorder.h"
+#include "bot.h"
+#include "cycleprof.h"
+#include "host_timer.h"
+
+#define LATENCY_BUCKET_NS 4
+#define LATENCY_BUCKETS   65536 // about 262 us, slower ticks land in the last bucket
+
+struct batchStats {
+    uint64_t ticks;
+    uint64_t steppedTicks; // ticks run through physicsStep(); the rest were fast-forwarded
+    uint64_t idlePeriods; // runs of fast-forwarded ticks, each one wakeup on the target
+    uint64_t stepNs;
+    uint64_t maxTickNs;
+    uint64_t latency[LATENCY_BUCKETS];
+    int outcomes[4]; // indexed by the states enum; active counts timeouts
+    uint64_t endedTicks;
+    uint32_t shortestGame;
+    uint32_t longestGame;
+    uint64_t satchelsThrown;
+    uint64_t satchelsIntercepted;
+    uint64_t shotsFired;
+    uint64_t shieldsActivated;
+    uint64_t usefulShields;
+    uint64_t recordBytes;
+    int replayMismatches;
+};
+
+static struct gameState state;
+static struct gameState replayState;
+static struct batchStats stats;
+static struct recorder recorder;
+static uint8_t record[RECORDER_RING_BYTES];
+
+// Plays a record back on a second engine and compares the outcome it stored
+static bool replayMatches(const uint8_t *data, uint32_t length)
+{
+    struct replay rp;
+    struct physicsConstants consts;
+    struct gameInputs in;
+    struct gameData expected;
+    uint32_t seed;
+    if (!replayOpen(&rp, data, length, &seed, &consts)) {
+        return false;
+    }
+    gameInit(&replayState, &consts, seed);
+    fix16_t dt = fix16FromFrac(consts.physicsPeriod, 1000);
+    while (replayNext(&rp, &in)) {
+        physicsStep(&replayState, &in, dt);
+    }
+    return replayOutcome(&rp, &expected) && replaySameOutcome(&expected, &replayState.game);
+}
+
+static void playGame(uint32_t seed, enum botPolicy policy, uint32_t maxTicks, int profile,
+                     bool verify, const char *recordPath)
+{
+    const struct physicsConstants *consts = &physicsProfiles[profile].consts;
+    const fix16_t dt = fix16FromFrac(consts->physicsPeriod, 1000);
+    const angle_t baseAim = angleFromDegrees(consts->railGunConst.railgunAngle);
+    struct bot bot;
+    struct gameInputs in;
+    botInit(&bot, policy, seed, baseAim);
+    gameInitProfile(&state, profile, seed);
+    recorderBegin(&recorder, seed, consts);
+    uint32_t tick = 0;
+    bool idle = false;
+    while (state.game.state == active && tick < maxTicks) {
+        CYCLE_BEGIN(mark);
+        botInputs(&bot, &state, &in);
+        recorderTick(&recorder, &in);
+        CYCLE_END(phaseInputs, mark);
+        // Like the physics task, fast-forward steps that would only advance the clock
+        if (gameQuietSteps(&state, &in) > 0) {
+            gameSkipSteps(&state, &in, 1);
+            stats.idlePeriods += !idle;
+            idle = true;
+            tick++;
+            continue;
+        }
+        idle = false;
+        stats.steppedTicks++;
+        uint64_t start = hostTimeNs();
+        CYCLE_BEGIN(stepMark);
+        physicsStep(&state, &in, dt);
+        CYCLE_END(phaseStep, stepMark);
+        uint64_t ns = hostTimeNs() - start;
+        uint64_t bucket = ns / LATENCY_BUCKET_NS;
+        stats.latency[bucket < LATENCY_BUCKETS ? bucket : LATENCY_BUCKETS - 1]++;
+        stats.stepNs += ns;
+        if (ns > stats.maxTickNs) {
+            stats.maxTickNs = ns;
+        }
+        tick++;
+    }
+    stats.ticks += tick;
+    stats.outcomes[state.game.state]++;
+    if (state.game.state != active) {
+        stats.endedTicks += tick;
+        if (tick < stats.shortestGame) {
+            stats.shortestGame = tick;
+        }
+        if (tick > stats.longestGame) {
+            stats.longestGame = tick;
+        }
+    }
+    stats.satchelsThrown += state.game.satchelsThrown;
+    stats.satchelsIntercepted += state.game.satchelsIntercepted;
+    stats.shotsFired += state.game.shotsFired;
+    stats.shieldsActivated += state.game.shieldsActivated;
+    stats.usefulShields += state.game.usefulShields;
+    recorderFinish(&recorder, &state.game);
+    uint32_t length = recorderExport(&recorder, 0, record, sizeof(record));
+    stats.recordBytes += length;
+    if (length == 0 || (verify && !replayMatches(record, length))) {
+        stats.replayMismatches++;
+        fprintf(stderr, "seed %u: record %s\n", seed, length ? "replays differently" : "overflowed the ring");
+    }
+    if (recordPath) {
+        FILE *f = fopen(recordPath, "wb");
+        if (!f || fwrite(record, 1, length, f) != length) {
+            perror(recordPath);
+            exit(1);
+        }
+        fclose(f);
+    }
+}
+
+static double percentileNs(double fraction)
+{
+    uint64_t target = (uint64_t)(fraction * stats.steppedTicks);
+    uint64_t seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        seen += stats.latency[i];
+        if (seen > target) {
+            return (double)(i + 1) * LATENCY_BUCKET_NS;
+        }
+    }
+    return (double)stats.maxTickNs;
+}
+
+#if CYCLE_PROFILING
+static void printPhaseLine(const char *line)
+{
+    fputs(line, stdout);
+}
+#endif
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-n games] [-s seed] [-p idle|random|defend] [-t max seconds per game]\n"
+                    "       [-P profile] [-o record file] [-v]\n", name);
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    int games = 1000;
+    uint32_t seed = GAME_DEFAULT_SEED;
+    enum botPolicy policy = botRandom;
+    int maxSeconds = 600;
+    const char *recordPath = NULL;
+    bool verify = false;
+    int profile = PHYSICS_DEFAULT_PROFILE;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:s:p:t:P:o:v")) != -1) {
+        switch (opt) {
+          case 'n': games = atoi(optarg); break;
+          case 's': seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+          case 't': maxSeconds = atoi(optarg); break;
+          case 'o': recordPath = optarg; break;
+          case 'P':
+              if ((profile = physicsProfileFromName(optarg)) < 0) {
+                  usage(argv[0]);
+              }
+              break;
+          case 'v': verify = true; break;
+          case 'p':
+              if (!botPolicyFromName(optarg, &policy)) {
+                  usage(argv[0]);
+              }
+              break;
+          default:
+              usage(argv[0]);
+        }
+    }
+    if (games <= 0 || maxSeconds <= 0) {
+        usage(argv[0]);
+    }
+    const struct physicsConstants consts = physicsProfiles[profile].consts;
+    uint32_t maxTicks = (uint32_t)maxSeconds * 1000u / (uint32_t)consts.physicsPeriod;
+    stats.shortestGame = UINT32_MAX;
+    recorderInit(&recorder);
+    CYCLE_INIT();
+
+    uint64_t start = hostTimeNs();
+    for (int g = 0; g < games; g++) {
+        playGame(seed + (uint32_t)g, policy, maxTicks, profile, verify, g == 0 ? recordPath : NULL);
+    }
+    double wallS = (double)(hostTimeNs() - start) / 1e9;
+    double simS = (double)stats.ticks * consts.physicsPeriod / 1000.0;
+
+    printf("games           %d (seeds %u..%u), profile %s\n", games, seed, seed + (uint32_t)games - 1,
+           physicsProfiles[profile].name);
+    printf("ticks           %llu\n", (unsigned long long)stats.ticks);
+    printf("games/sec       %.0f\n", games / wallS);
+    printf("ticks/sec       %.0f (%.0fx real time)\n", stats.ticks / wallS, simS / wallS);
+    printf("tick latency    mean %.0f ns, p50 %.0f, p90 %.0f, p99 %.0f, p99.9 %.0f, max %llu ns\n",
+           (double)stats.stepNs / stats.steppedTicks, percentileNs(0.50), percentileNs(0.90),
+           percentileNs(0.99), percentileNs(0.999), (unsigned long long)stats.maxTickNs);
+    uint64_t skipped = stats.ticks - stats.steppedTicks;
+    printf("idle            %.1f%% of ticks fast-forwarded, %.0f per minute; %.0f wakeups per minute instead of %.0f\n",
+           100.0 * skipped / stats.ticks, skipped / (simS / 60),
+           (stats.steppedTicks + stats.idlePeriods) / (simS / 60), stats.ticks / (simS / 60));
+    printf("outcomes        win %.1f%%, fail %.1f%%, timeout %.1f%%\n",
+           100.0 * stats.outcomes[win] / games, 100.0 * stats.outcomes[fail] / games,
+           100.0 * stats.outcomes[active] / games);
+    int ended = stats.outcomes[win] + stats.outcomes[fail];
+    if (ended > 0) {
+        double tickS = consts.physicsPeriod / 1000.0;
+        printf("game length     mean %.1f s, min %.1f s, max %.1f s (finished games)\n",
+               (double)stats.endedTicks / ended * tickS, stats.shortestGame * tickS, stats.longestGame * tickS);
+    }
+    printf("per game        %.1f satchels, %.1f intercepted, %.1f shots, %.1f shields (%.1f useful)\n",
+           (double)stats.satchelsThrown / games, (double)stats.satchelsIntercepted / games,
+           (double)stats.shotsFired / games, (double)stats.shieldsActivated / games,
+           (double)stats.usefulShields / games);
+    printf("records         %.0f bytes/game, %.0f bytes/minute of play\n",
+           (double)stats.recordBytes / games, stats.recordBytes / (simS / 60));
+    if (verify || stats.replayMismatches) {
+        printf("replay          %d of %d records reproduce their outcome\n", games - stats.replayMismatches, games);
+    }
+#if CYCLE_PROFILING
+    printf("phases (ns, built with PROFILE=1)\n");
+    cycleProfileRequestReport();
+#endif
+    CYCLE_SERVICE(printPhaseLine);
+    return stats.replayMismatches ? 1 : 0;
+}
@@ -0,0 +1,75 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host stand-in for the Gecko SDK's GLIB
+ *******************************************************************************
+ * The part of GLIB's API the game draws with, same names and signatures, so
+ * render.c builds unchanged on Linux. glib_host.c draws through the host
+ * DMD of dmd.h into a 128x128 1bpp framebuffer laid out as the memory LCD
+ * DMD's. See glib_host.h for how closely the shapes follow the SDK.
+ ******************************************************************************/
+
+#ifndef GLIB_H
+#define GLIB_H
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef uint32_t EMSTATUS;
+
+#define GLIB_OK                       0
+#define GLIB_ERROR_INVALID_ARGUMENT   1
+#define GLIB_ERROR_NOTHING_TO_DRAW    2
+#define GLIB_ERROR_INVALID_CHAR       3
+
+#define Black 0x000000
+#define White 0xffffff
+
+typedef enum {GLIB_ALIGN_LEFT, GLIB_ALIGN_CENTER, GLIB_ALIGN_RIGHT} GLIB_Align_t;
+
+typedef enum {NumbersOnly, FullFont} GLIB_Font_Class;
+
+typedef struct __GLIB_Font_t {
+    const void *pFontPixMap;
+    uint16_t cntOfMapElements;
+    uint8_t sizeOfMapElement;
+    uint8_t fontRowOffset; // bytes from one row of a glyph to the next
+    uint8_t fontWidth;
+    uint8_t fontHeight;
+    uint8_t lineSpacing;
+    uint8_t charSpacing;
+    GLIB_Font_Class class;
+} GLIB_Font_t;
+
+typedef struct __GLIB_Rectangle_t {
+    int32_t xMin;
+    int32_t yMin;
+    int32_t xMax;
+    int32_t yMax;
+} GLIB_Rectangle_t;
+
+typedef struct __GLIB_Context_t {
+    GLIB_Rectangle_t clippingRegion;
+    uint32_t backgroundColor;
+    uint32_t foregroundColor;
+    GLIB_Font_t font;
+} GLIB_Context_t;
+
+extern const GLIB_Font_t GLIB_FontNarrow6x8;
+extern const GLIB_Font_t GLIB_FontNormal8x8;
+
+EMSTATUS GLIB_contextInit(GLIB_Context_t *pContext);
+EMSTATUS GLIB_setFont(GLIB_Context_t *pContext, GLIB_Font_t *pFont);
+EMSTATUS GLIB_clear(GLIB_Context_t *pContext);
+EMSTATUS GLIB_drawPixel(GLIB_Context_t *pContext, int32_t x, int32_t y);
+EMSTATUS GLIB_drawLineH(GLIB_Context_t *pContext, int32_t x1, int32_t y1, int32_t x2);
+EMSTATUS GLIB_drawLineV(GLIB_Context_t *pContext, int32_t x1, int32_t y1, int32_t y2);
+EMSTATUS GLIB_drawLine(GLIB_Context_t *pContext, int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+EMSTATUS GLIB_drawRectFilled(GLIB_Context_t *pContext, const GLIB_Rectangle_t *pRect);
+EMSTATUS GLIB_drawCircle(GLIB_Context_t *pContext, int32_t xCenter, int32_t yCenter, uint32_t radius);
+EMSTATUS GLIB_drawCircleFilled(GLIB_Context_t *pContext, int32_t xCenter, int32_t yCenter, uint32_t radius);
+EMSTATUS GLIB_drawChar(GLIB_Context_t *pContext, char myChar, int32_t x, int32_t y, bool opaque);
+EMSTATUS GLIB_drawString(GLIB_Context_t *pContext, const char *pString, uint32_t sLength, int32_t x0, int32_t y0,
+                         bool opaque);
+EMSTATUS GLIB_drawStringOnLine(GLIB_Context_t *pContext, const char *pString, uint8_t line, GLIB_Align_t align,
+                               int32_t xOffset, int32_t yOffset, bool opaque);
+
+#endif // GLIB_H
@@ -0,0 +1,182 @@
+/***************************************************************************//**
+ * @file
+ * @brief GLIB's 6x8 and 8x8 fonts for the host GLIB
+ *******************************************************************************
+ * The glyphs of the Gecko SDK 3.2 glib_font_narrow_6x8.c and
+ * glib_font_normal_8x8.c (Silicon Laboratories Inc., under the SDK's
+ * license), taken from the target build, so that host frames carry the same
+ * text as the panel. 100 glyphs from ' ', one byte per glyph row with bit 0
+ * leftmost; all first rows, then all second rows, and so on.
+ ******************************************************************************/
+
+#include "glib.h"
+
+static const uint8_t GLIB_FontNarrow6x8PixMap[800] = {
+    // row 0
+    0x00, 0x04, 0x0a, 0x0a, 0x04, 0x03, 0x06, 0x06, 0x08, 0x02, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x0e, 0x04, 0x0e, 0x1f, 0x08, 0x1f, 0x0c, 0x1f,
+    0x0e, 0x0e, 0x00, 0x00, 0x10, 0x00, 0x01, 0x0e, 0x0e, 0x0e, 0x0f, 0x0e,
+    0x07, 0x1f, 0x1f, 0x0e, 0x11, 0x0e, 0x1c, 0x11, 0x01, 0x11, 0x11, 0x0e,
+    0x0f, 0x0e, 0x0f, 0x1e, 0x1f, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1f, 0x0e,
+    0x00, 0x0e, 0x04, 0x00, 0x02, 0x00, 0x01, 0x00, 0x10, 0x00, 0x0c, 0x00,
+    0x01, 0x04, 0x08, 0x01, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x04, 0x06, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // row 1
+    0x00, 0x04, 0x0a, 0x0a, 0x1e, 0x13, 0x09, 0x04, 0x04, 0x04, 0x04, 0x04,
+    0x00, 0x00, 0x00, 0x00, 0x11, 0x06, 0x11, 0x08, 0x0c, 0x01, 0x02, 0x10,
+    0x11, 0x11, 0x06, 0x06, 0x08, 0x00, 0x02, 0x11, 0x10, 0x11, 0x11, 0x11,
+    0x09, 0x01, 0x01, 0x11, 0x11, 0x04, 0x08, 0x09, 0x01, 0x1b, 0x11, 0x11,
+    0x11, 0x11, 0x11, 0x01, 0x04, 0x11, 0x11, 0x11, 0x11, 0x11, 0x10, 0x02,
+    0x00, 0x08, 0x0a, 0x00, 0x04, 0x00, 0x01, 0x00, 0x10, 0x00, 0x12, 0x1e,
+    0x01, 0x00, 0x00, 0x01, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x04, 0x08, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // row 2
+    0x00, 0x04, 0x0a, 0x1f, 0x01, 0x08, 0x05, 0x02, 0x02, 0x08, 0x15, 0x04,
+    0x00, 0x00, 0x00, 0x10, 0x19, 0x04, 0x10, 0x04, 0x0a, 0x0f, 0x01, 0x08,
+    0x11, 0x11, 0x06, 0x06, 0x04, 0x1f, 0x04, 0x10, 0x10, 0x11, 0x11, 0x01,
+    0x11, 0x01, 0x01, 0x01, 0x11, 0x04, 0x08, 0x05, 0x01, 0x15, 0x13, 0x11,
+    0x11, 0x11, 0x11, 0x01, 0x04, 0x11, 0x11, 0x11, 0x0a, 0x11, 0x08, 0x02,
+    0x01, 0x08, 0x11, 0x00, 0x08, 0x0e, 0x0d, 0x0e, 0x16, 0x0e, 0x02, 0x11,
+    0x0d, 0x06, 0x0c, 0x09, 0x04, 0x0b, 0x0d, 0x0e, 0x0f, 0x16, 0x0d, 0x0e,
+    0x07, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1f, 0x02, 0x04, 0x08, 0x15, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // row 3
+    0x00, 0x04, 0x00, 0x0a, 0x0e, 0x04, 0x02, 0x00, 0x02, 0x08, 0x0e, 0x1f,
+    0x00, 0x1f, 0x00, 0x08, 0x15, 0x04, 0x08, 0x08, 0x09, 0x10, 0x0f, 0x04,
+    0x0e, 0x1e, 0x00, 0x00, 0x02, 0x00, 0x08, 0x08, 0x16, 0x11, 0x0f, 0x01,
+    0x11, 0x0f, 0x0f, 0x1d, 0x1f, 0x04, 0x08, 0x03, 0x01, 0x15, 0x15, 0x11,
+    0x0f, 0x11, 0x0f, 0x0e, 0x04, 0x11, 0x11, 0x15, 0x04, 0x0a, 0x04, 0x02,
+    0x02, 0x08, 0x00, 0x00, 0x00, 0x10, 0x13, 0x01, 0x19, 0x11, 0x07, 0x11,
+    0x13, 0x04, 0x08, 0x05, 0x04, 0x15, 0x13, 0x11, 0x11, 0x19, 0x13, 0x01,
+    0x02, 0x11, 0x11, 0x11, 0x0a, 0x11, 0x08, 0x01, 0x04, 0x10, 0x08, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // row 4
+    0x00, 0x00, 0x00, 0x1f, 0x10, 0x02, 0x15, 0x00, 0x02, 0x08, 0x15, 0x04,
+    0x06, 0x00, 0x00, 0x04, 0x13, 0x04, 0x04, 0x10, 0x1f, 0x10, 0x11, 0x02,
+    0x11, 0x10, 0x06, 0x06, 0x04, 0x1f, 0x04, 0x04, 0x15, 0x1f, 0x11, 0x01,
+    0x11, 0x01, 0x01, 0x11, 0x11, 0x04, 0x08, 0x05, 0x01, 0x11, 0x19, 0x11,
+    0x01, 0x15, 0x05, 0x10, 0x04, 0x11, 0x11, 0x15, 0x0a, 0x04, 0x02, 0x02,
+    0x04, 0x08, 0x00, 0x00, 0x00, 0x1e, 0x11, 0x01, 0x11, 0x1f, 0x02, 0x1e,
+    0x11, 0x04, 0x08, 0x03, 0x04, 0x15, 0x11, 0x11, 0x0f, 0x1e, 0x01, 0x0e,
+    0x02, 0x11, 0x11, 0x15, 0x04, 0x1e, 0x04, 0x02, 0x04, 0x08, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // row 5
+    0x00, 0x00, 0x00, 0x0a, 0x0f, 0x19, 0x09, 0x00, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x00, 0x06, 0x02, 0x11, 0x04, 0x02, 0x11, 0x08, 0x11, 0x11, 0x02,
+    0x11, 0x08, 0x06, 0x04, 0x08, 0x00, 0x02, 0x00, 0x15, 0x11, 0x11, 0x11,
+    0x09, 0x01, 0x01, 0x11, 0x11, 0x04, 0x09, 0x09, 0x01, 0x11, 0x11, 0x11,
+    0x01, 0x09, 0x09, 0x10, 0x04, 0x11, 0x0a, 0x15, 0x11, 0x04, 0x01, 0x02,
+    0x08, 0x08, 0x00, 0x00, 0x00, 0x11, 0x11, 0x11, 0x11, 0x01, 0x02, 0x10,
+    0x11, 0x04, 0x09, 0x05, 0x04, 0x11, 0x11, 0x11, 0x01, 0x10, 0x01, 0x10,
+    0x12, 0x19, 0x0a, 0x15, 0x0a, 0x10, 0x02, 0x02, 0x04, 0x08, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // row 6
+    0x00, 0x04, 0x00, 0x0a, 0x04, 0x18, 0x16, 0x00, 0x08, 0x02, 0x00, 0x00,
+    0x02, 0x00, 0x06, 0x01, 0x0e, 0x0e, 0x1f, 0x0e, 0x08, 0x0e, 0x0e, 0x02,
+    0x0e, 0x06, 0x00, 0x02, 0x10, 0x00, 0x01, 0x04, 0x0e, 0x11, 0x0f, 0x0e,
+    0x07, 0x1f, 0x01, 0x0e, 0x11, 0x0e, 0x06, 0x11, 0x1f, 0x11, 0x11, 0x0e,
+    0x01, 0x16, 0x11, 0x0f, 0x04, 0x0e, 0x04, 0x0a, 0x11, 0x04, 0x1f, 0x0e,
+    0x10, 0x0e, 0x00, 0x1f, 0x00, 0x1e, 0x0f, 0x0e, 0x1e, 0x0e, 0x02, 0x0e,
+    0x11, 0x0e, 0x06, 0x09, 0x0e, 0x11, 0x11, 0x0e, 0x01, 0x10, 0x01, 0x0f,
+    0x0c, 0x16, 0x04, 0x0a, 0x11, 0x0e, 0x1f, 0x0c, 0x04, 0x06, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // row 7
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+};
+
+const GLIB_Font_t GLIB_FontNarrow6x8 = {GLIB_FontNarrow6x8PixMap, 800, 1, 100, 6, 8, 2, 0, FullFont};
+
+static const uint8_t GLIB_FontNormal8x8PixMap[800] = {
+    // row 0
+    0x00, 0x18, 0x6c, 0x6c, 0x10, 0xce, 0x38, 0x08, 0x60, 0x0c, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x7c, 0x30, 0x7c, 0x7c, 0xc6, 0xfe, 0x7c, 0xfe,
+    0x7c, 0x7c, 0x00, 0x00, 0x70, 0x00, 0x1c, 0x7c, 0x7c, 0x7c, 0x7e, 0x7c,
+    0x7e, 0xfe, 0xfe, 0x7c, 0xc6, 0x3c, 0x78, 0xc6, 0x06, 0xc6, 0xc6, 0x7c,
+    0x7e, 0x7c, 0x7e, 0x7c, 0x7e, 0xc6, 0xc6, 0xc6, 0xc6, 0xc6, 0xfe, 0x7c,
+    0x00, 0x7c, 0x10, 0x00, 0x0c, 0x00, 0x06, 0x00, 0x60, 0x00, 0x38, 0x00,
+    0x06, 0x00, 0x00, 0x06, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x18, 0x18, 0x8c, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // row 1
+    0x00, 0x18, 0x6c, 0xfe, 0xfc, 0x6a, 0x2c, 0x18, 0x30, 0x18, 0x6c, 0x18,
+    0x00, 0x00, 0x00, 0xc0, 0xc6, 0x38, 0xc6, 0xc6, 0xc6, 0x06, 0xc6, 0xc0,
+    0xc6, 0xc6, 0x18, 0x18, 0x38, 0x7c, 0x38, 0xc6, 0xc6, 0xc6, 0xc6, 0xc6,
+    0xc6, 0x06, 0x06, 0xc6, 0xc6, 0x18, 0x30, 0x66, 0x06, 0xee, 0xce, 0xc6,
+    0xc6, 0xc6, 0xc6, 0xc6, 0x18, 0xc6, 0xc6, 0xc6, 0xc6, 0xc6, 0xc0, 0x0c,
+    0x06, 0x60, 0x38, 0x00, 0x0c, 0x00, 0x06, 0x00, 0x60, 0x00, 0x0c, 0x00,
+    0x06, 0x18, 0x30, 0x06, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x30, 0xd6, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // row 2
+    0x00, 0x18, 0x48, 0xfe, 0x16, 0x2e, 0x2c, 0x18, 0x18, 0x30, 0x38, 0x18,
+    0x00, 0x00, 0x00, 0x60, 0xc6, 0x30, 0x60, 0xc0, 0xc6, 0x06, 0x06, 0x60,
+    0xc6, 0xc6, 0x18, 0x18, 0x1c, 0x7c, 0x70, 0xc6, 0xf6, 0xc6, 0xc6, 0x06,
+    0xc6, 0x06, 0x06, 0x06, 0xc6, 0x18, 0x30, 0x36, 0x06, 0xfe, 0xde, 0xc6,
+    0xc6, 0xc6, 0xc6, 0x06, 0x18, 0xc6, 0xc6, 0xc6, 0x6c, 0xc6, 0x60, 0x0c,
+    0x0c, 0x60, 0x6c, 0x00, 0x04, 0x3c, 0x3e, 0x3c, 0x7c, 0x3c, 0x3c, 0x3c,
+    0x3e, 0x00, 0x00, 0x66, 0x0c, 0x6e, 0x3e, 0x3c, 0x3e, 0x3c, 0x36, 0x3c,
+    0x18, 0x66, 0x66, 0xc6, 0x66, 0x66, 0x7e, 0x18, 0x18, 0x30, 0x62, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // row 3
+    0x00, 0x18, 0x00, 0x6c, 0x7c, 0x10, 0xdc, 0x00, 0x18, 0x30, 0xfe, 0x7e,
+    0x1c, 0x7e, 0x00, 0x30, 0xc6, 0x30, 0x30, 0x70, 0xfe, 0x7e, 0x7e, 0x30,
+    0x7c, 0xfc, 0x00, 0x00, 0x0e, 0x00, 0xe0, 0x70, 0xf6, 0xfe, 0x7e, 0x06,
+    0xc6, 0x1e, 0x1e, 0xf6, 0xfe, 0x18, 0x30, 0x1e, 0x06, 0xd6, 0xf6, 0xc6,
+    0x7e, 0xc6, 0x7e, 0x7c, 0x18, 0xc6, 0xc6, 0xd6, 0x38, 0xfc, 0x30, 0x0c,
+    0x18, 0x60, 0xc6, 0x00, 0x00, 0x60, 0x66, 0x06, 0x66, 0x66, 0x0c, 0x66,
+    0x66, 0x18, 0x30, 0x36, 0x0c, 0xd6, 0x66, 0x66, 0x66, 0x66, 0x6e, 0x06,
+    0x7c, 0x66, 0x66, 0xc6, 0x3c, 0x66, 0x30, 0x0c, 0x00, 0x60, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // row 4
+    0x00, 0x00, 0x00, 0xfe, 0xd0, 0xe8, 0x66, 0x00, 0x18, 0x30, 0x38, 0x7e,
+    0x1c, 0x7e, 0x1c, 0x18, 0xc6, 0x30, 0x18, 0xc0, 0xc0, 0xc0, 0xc6, 0x18,
+    0xc6, 0xc0, 0x18, 0x18, 0x1c, 0x7c, 0x70, 0x30, 0x76, 0xc6, 0xc6, 0x06,
+    0xc6, 0x06, 0x06, 0xc6, 0xc6, 0x18, 0x30, 0x36, 0x06, 0xc6, 0xe6, 0xc6,
+    0x06, 0xb6, 0xc6, 0xc0, 0x18, 0xc6, 0xc6, 0xfe, 0x6c, 0xc0, 0x18, 0x0c,
+    0x30, 0x60, 0x00, 0x00, 0x00, 0x7c, 0x66, 0x06, 0x66, 0x7e, 0x0c, 0x7c,
+    0x66, 0x18, 0x30, 0x1e, 0x0c, 0xd6, 0x66, 0x66, 0x3e, 0x56, 0x06, 0x3c,
+    0x18, 0x66, 0x66, 0xd6, 0x18, 0x7c, 0x18, 0x18, 0x18, 0x30, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // row 5
+    0x00, 0x18, 0x00, 0xfe, 0x7e, 0xac, 0x66, 0x00, 0x30, 0x18, 0x6c, 0x18,
+    0x18, 0x00, 0x1c, 0x0c, 0xc6, 0x30, 0x0c, 0xc6, 0xc0, 0xc6, 0xc6, 0x0c,
+    0xc6, 0xc6, 0x18, 0x18, 0x38, 0x7c, 0x38, 0x00, 0x06, 0xc6, 0xc6, 0xc6,
+    0xc6, 0x06, 0x06, 0xc6, 0xc6, 0x18, 0x36, 0x66, 0x06, 0xc6, 0xc6, 0xc6,
+    0x06, 0x66, 0xc6, 0xc6, 0x18, 0xc6, 0x6c, 0xee, 0xc6, 0xc0, 0x0c, 0x0c,
+    0x60, 0x60, 0x00, 0xfe, 0x00, 0x66, 0x66, 0x06, 0x66, 0x06, 0x0c, 0x60,
+    0x66, 0x18, 0x36, 0x36, 0x0c, 0xc6, 0x66, 0x66, 0x06, 0x26, 0x06, 0x60,
+    0x18, 0x66, 0x3c, 0xd6, 0x3c, 0x60, 0x0c, 0x18, 0x18, 0x30, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // row 6
+    0x00, 0x18, 0x00, 0x6c, 0x10, 0xe6, 0xdc, 0x00, 0x60, 0x0c, 0x00, 0x18,
+    0x0c, 0x00, 0x1c, 0x06, 0x7c, 0x78, 0xfe, 0x7c, 0xc0, 0x7c, 0x7c, 0x06,
+    0x7c, 0x7c, 0x00, 0x0c, 0x70, 0x00, 0x1c, 0x30, 0x7c, 0xc6, 0x7e, 0x7c,
+    0x7e, 0xfe, 0x06, 0xfc, 0xc6, 0x3c, 0x1c, 0xc6, 0xfe, 0xc6, 0xc6, 0x7c,
+    0x06, 0xdc, 0xc6, 0x7c, 0x18, 0x7c, 0x38, 0xc6, 0xc6, 0x7e, 0xfe, 0x7c,
+    0xc0, 0x7c, 0x00, 0xfe, 0x00, 0x7c, 0x3e, 0x3c, 0x7c, 0x3c, 0x0c, 0x3e,
+    0x66, 0x70, 0x1c, 0x66, 0x38, 0xc6, 0x66, 0x3c, 0x06, 0x5c, 0x06, 0x3e,
+    0x70, 0x7c, 0x18, 0xfc, 0x66, 0x3e, 0x7e, 0x30, 0x18, 0x18, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    // row 7
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+};
+
+const GLIB_Font_t GLIB_FontNormal8x8 = {GLIB_FontNormal8x8PixMap, 800, 1, 100, 8, 8, 2, 0, FullFont};
@@ -0,0 +1,329 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host GLIB/DMD drawing into a 128x128 1bpp framebuffer
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dmd.h"
+#include "glib.h"
+#include "glib_host.h"
+
+static uint32_t framebuffer[FRAMEBUF_WORDS];
+uint32_t hostPanel[FRAMEBUF_WORDS];
+uint32_t hostPanelUpdates;
+
+EMSTATUS DMD_init(void *param)
+{
+    (void)param;
+    memset(framebuffer, 0xff, sizeof(framebuffer));
+    memset(hostPanel, 0xff, sizeof(hostPanel));
+    hostPanelUpdates = 0;
+    return DMD_OK;
+}
+
+EMSTATUS DMD_getFrameBuffer(void **fb)
+{
+    *fb = framebuffer;
+    return DMD_OK;
+}
+
+EMSTATUS DMD_updateDisplay(void)
+{
+    memcpy(hostPanel, framebuffer, sizeof(hostPanel));
+    hostPanelUpdates++;
+    return DMD_OK;
+}
+
+// The DMD's one-pixel write, clipped to the context's region
+static void writePixel(const GLIB_Context_t *pContext, int32_t x, int32_t y, uint32_t color)
+{
+    if (x < pContext->clippingRegion.xMin || x > pContext->clippingRegion.xMax || y < pContext->clippingRegion.yMin ||
+        y > pContext->clippingRegion.yMax) {
+        return;
+    }
+    uint8_t *byte = (uint8_t *)framebuffer + y * LCD_LINE_BYTES + x / 8;
+    uint8_t bit = (uint8_t)(1u << (x % 8));
+    if (color == Black) {
+        *byte &= (uint8_t)~bit;
+    } else {
+        *byte |= bit;
+    }
+}
+
+EMSTATUS GLIB_contextInit(GLIB_Context_t *pContext)
+{
+    if (pContext == NULL) {
+        return GLIB_ERROR_INVALID_ARGUMENT;
+    }
+    pContext->clippingRegion.xMin = 0;
+    pContext->clippingRegion.yMin = 0;
+    pContext->clippingRegion.xMax = LCD_WIDTH - 1;
+    pContext->clippingRegion.yMax = LCD_HEIGHT - 1;
+    pContext->backgroundColor = White;
+    pContext->foregroundColor = Black;
+    pContext->font = GLIB_FontNarrow6x8;
+    return GLIB_OK;
+}
+
+EMSTATUS GLIB_setFont(GLIB_Context_t *pContext, GLIB_Font_t *pFont)
+{
+    if (pContext == NULL || pFont == NULL) {
+        return GLIB_ERROR_INVALID_ARGUMENT;
+    }
+    pContext->font = *pFont;
+    return GLIB_OK;
+}
+
+EMSTATUS GLIB_clear(GLIB_Context_t *pContext)
+{
+    memset(framebuffer, pContext->backgroundColor == Black ? 0x00 : 0xff, sizeof(framebuffer));
+    return GLIB_OK;
+}
+
+EMSTATUS GLIB_drawPixel(GLIB_Context_t *pContext, int32_t x, int32_t y)
+{
+    writePixel(pContext, x, y, pContext->foregroundColor);
+    return GLIB_OK;
+}
+
+EMSTATUS GLIB_drawLineH(GLIB_Context_t *pContext, int32_t x1, int32_t y1, int32_t x2)
+{
+    if (x1 > x2) {
+        int32_t t = x1;
+        x1 = x2;
+        x2 = t;
+    }
+    for (int32_t x = x1; x <= x2; x++) {
+        writePixel(pContext, x, y1, pContext->foregroundColor);
+    }
+    return GLIB_OK;
+}
+
+EMSTATUS GLIB_drawLineV(GLIB_Context_t *pContext, int32_t x1, int32_t y1, int32_t y2)
+{
+    if (y1 > y2) {
+        int32_t t = y1;
+        y1 = y2;
+        y2 = t;
+    }
+    for (int32_t y = y1; y <= y2; y++) {
+        writePixel(pContext, x1, y, pContext->foregroundColor);
+    }
+    return GLIB_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Bresenham, walked from the left end (the top end when steep).
+ ******************************************************************************/
+EMSTATUS GLIB_drawLine(GLIB_Context_t *pContext, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    if (x1 == x2) {
+        return GLIB_drawLineV(pContext, x1, y1, y2);
+    }
+    if (y1 == y2) {
+        return GLIB_drawLineH(pContext, x1, y1, x2);
+    }
+    bool steep = abs(y2 - y1) > abs(x2 - x1);
+    int32_t t;
+    if (steep) {
+        t = x1, x1 = y1, y1 = t;
+        t = x2, x2 = y2, y2 = t;
+    }
+    if (x1 > x2) {
+        t = x1, x1 = x2, x2 = t;
+        t = y1, y1 = y2, y2 = t;
+    }
+    int32_t dx = x2 - x1;
+    int32_t dy = abs(y2 - y1);
+    int32_t step = y1 < y2 ? 1 : -1;
+    int32_t error = dx / 2;
+    for (int32_t x = x1, y = y1; x <= x2; x++) {
+        if (steep) {
+            writePixel(pContext, y, x, pContext->foregroundColor);
+        } else {
+            writePixel(pContext, x, y, pContext->foregroundColor);
+        }
+        error -= dy;
+        if (error < 0) {
+            y += step;
+            error += dx;
+        }
+    }
+    return GLIB_OK;
+}
+
+EMSTATUS GLIB_drawRectFilled(GLIB_Context_t *pContext, const GLIB_Rectangle_t *pRect)
+{
+    for (int32_t y = pRect->yMin; y <= pRect->yMax; y++) {
+        for (int32_t x = pRect->xMin; x <= pRect->xMax; x++) {
+            writePixel(pContext, x, y, pContext->foregroundColor);
+        }
+    }
+    return GLIB_OK;
+}
+
+static void circlePoints(GLIB_Context_t *pContext, int32_t xc, int32_t yc, int32_t x, int32_t y)
+{
+    uint32_t color = pContext->foregroundColor;
+    writePixel(pContext, xc + x, yc + y, color);
+    writePixel(pContext, xc - x, yc + y, color);
+    writePixel(pContext, xc + x, yc - y, color);
+    writePixel(pContext, xc - x, yc - y, color);
+    writePixel(pContext, xc + y, yc + x, color);
+    writePixel(pContext, xc - y, yc + x, color);
+    writePixel(pContext, xc + y, yc - x, color);
+    writePixel(pContext, xc - y, yc - x, color);
+}
+
+EMSTATUS GLIB_drawCircle(GLIB_Context_t *pContext, int32_t xCenter, int32_t yCenter, uint32_t radius)
+{
+    int32_t x = 0, y = (int32_t)radius, d = 1 - (int32_t)radius;
+    circlePoints(pContext, xCenter, yCenter, x, y);
+    while (x < y) {
+        if (d < 0) {
+            d += 2 * x + 3;
+        } else {
+            d += 2 * (x - y) + 5;
+            y--;
+        }
+        x++;
+        circlePoints(pContext, xCenter, yCenter, x, y);
+    }
+    return GLIB_OK;
+}
+
+static void circleSpans(GLIB_Context_t *pContext, int32_t xc, int32_t yc, int32_t x, int32_t y)
+{
+    GLIB_drawLineH(pContext, xc - y, yc + x, xc + y);
+    GLIB_drawLineH(pContext, xc - y, yc - x, xc + y);
+    GLIB_drawLineH(pContext, xc - x, yc + y, xc + x);
+    GLIB_drawLineH(pContext, xc - x, yc - y, xc + x);
+}
+
+EMSTATUS GLIB_drawCircleFilled(GLIB_Context_t *pContext, int32_t xCenter, int32_t yCenter, uint32_t radius)
+{
+    int32_t x = 0, y = (int32_t)radius, d = 1 - (int32_t)radius;
+    circleSpans(pContext, xCenter, yCenter, x, y);
+    while (x < y) {
+        if (d < 0) {
+            d += 2 * x + 3;
+        } else {
+            d += 2 * (x - y) + 5;
+            y--;
+        }
+        x++;
+        circleSpans(pContext, xCenter, yCenter, x, y);
+    }
+    return GLIB_OK;
+}
+
+EMSTATUS GLIB_drawChar(GLIB_Context_t *pContext, char myChar, int32_t x, int32_t y, bool opaque)
+{
+    const GLIB_Font_t *font = &pContext->font;
+    int index = myChar - ' ';
+    if (index < 0 || index >= font->fontRowOffset) {
+        return GLIB_ERROR_INVALID_CHAR;
+    }
+    const uint8_t *pixMap = font->pFontPixMap;
+    for (int row = 0; row < font->fontHeight; row++) {
+        uint8_t pixels = pixMap[index + row * font->fontRowOffset];
+        for (int column = 0; column < font->fontWidth; column++, pixels >>= 1) {
+            if (pixels & 1) {
+                writePixel(pContext, x + column, y + row, pContext->foregroundColor);
+            } else if (opaque) {
+                writePixel(pContext, x + column, y + row, pContext->backgroundColor);
+            }
+        }
+    }
+    return GLIB_OK;
+}
+
+EMSTATUS GLIB_drawString(GLIB_Context_t *pContext, const char *pString, uint32_t sLength, int32_t x0, int32_t y0,
+                         bool opaque)
+{
+    int32_t x = x0, y = y0;
+    for (uint32_t i = 0; i < sLength; i++) {
+        if (pString[i] == '\n') {
+            x = x0;
+            y += pContext->font.fontHeight + pContext->font.lineSpacing;
+            continue;
+        }
+        GLIB_drawChar(pContext, pString[i], x, y, opaque);
+        x += pContext->font.fontWidth + pContext->font.charSpacing;
+    }
+    return GLIB_OK;
+}
+
+EMSTATUS GLIB_drawStringOnLine(GLIB_Context_t *pContext, const char *pString, uint8_t line, GLIB_Align_t align,
+                               int32_t xOffset, int32_t yOffset, bool opaque)
+{
+    uint32_t length = (uint32_t)strlen(pString);
+    int32_t width = (int32_t)length * (pContext->font.fontWidth + pContext->font.charSpacing);
+    int32_t x = xOffset;
+    int32_t y = line * (pContext->font.fontHeight + pContext->font.lineSpacing) + yOffset;
+    if (align == GLIB_ALIGN_CENTER) {
+        x = LCD_WIDTH / 2 - width / 2 + xOffset;
+    } else if (align == GLIB_ALIGN_RIGHT) {
+        x = LCD_WIDTH - width - xOffset;
+    }
+    return GLIB_drawString(pContext, pString, length, x, y, opaque);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Writes framebuffer as a binary PBM: MSB first and a set bit black, so
+ *   each byte is the framebuffer's reversed and inverted.
+ ******************************************************************************/
+bool hostWritePbm(const char *path, const void *fb)
+{
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        return false;
+    }
+    const uint8_t *in = fb;
+    uint8_t row[LCD_LINE_BYTES];
+    fprintf(f, "P4\n%d %d\n", LCD_WIDTH, LCD_HEIGHT);
+    for (int y = 0; y < LCD_HEIGHT; y++) {
+        for (int i = 0; i < LCD_LINE_BYTES; i++) {
+            uint8_t b = in[y * LCD_LINE_BYTES + i], out = 0;
+            for (int bit = 0; bit < 8; bit++) {
+                out |= (uint8_t)(((b >> bit) & 1) << (7 - bit));
+            }
+            row[i] = (uint8_t)~out;
+        }
+        fwrite(row, 1, sizeof(row), f);
+    }
+    return fclose(f) == 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Reads a 128x128 binary PBM as written by hostWritePbm() into fb.
+ ******************************************************************************/
+bool hostReadPbm(const char *path, void *fb)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return false;
+    }
+    int width, height;
+    bool ok = fscanf(f, "P4 %d %d", &width, &height) == 2 && width == LCD_WIDTH && height == LCD_HEIGHT &&
+              fgetc(f) != EOF;
+    uint8_t *out = fb;
+    uint8_t row[LCD_LINE_BYTES];
+    for (int y = 0; ok && y < LCD_HEIGHT; y++) {
+        ok = fread(row, 1, sizeof(row), f) == sizeof(row);
+        for (int i = 0; ok && i < LCD_LINE_BYTES; i++) {
+            uint8_t b = (uint8_t)~row[i], in = 0;
+            for (int bit = 0; bit < 8; bit++) {
+                in |= (uint8_t)(((b >> bit) & 1) << (7 - bit));
+            }
+            out[y * LCD_LINE_BYTES + i] = in;
+        }
+    }
+    fclose(f);
+    return ok;
+}
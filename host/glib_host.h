@@ -0,0 +1,30 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host GLIB/DMD: the panel, PBM files and how close to the SDK it is
+ *******************************************************************************
+ * glib.h and dmd.h give render.c the GLIB and DMD it draws with on the
+ * target. Shapes go through the same per-pixel DMD write as the memory LCD
+ * DMD, so relative costs resemble the target's, and are drawn with GLIB's
+ * algorithms: midpoint circles and spans, inclusive rectangles, 8x8 and 6x8
+ * glyphs from the SDK's own font tables. GLIB_drawLine() clips each pixel
+ * rather than the end points first, so a line leaving the screen may differ
+ * from the SDK's by a pixel near the edge.
+ *
+ * DMD_updateDisplay() copies the framebuffer to hostPanel, which stands for
+ * what the panel shows. PBM (P4) files hold a framebuffer as an image, black
+ * ink on white, for golden-image comparisons.
+ ******************************************************************************/
+
+#ifndef GLIB_HOST_H
+#define GLIB_HOST_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "framebuf.h"
+
+extern uint32_t hostPanel[FRAMEBUF_WORDS];
+extern uint32_t hostPanelUpdates; // DMD_updateDisplay() calls
+
+bool hostWritePbm(const char *path, const void *framebuffer);
+bool hostReadPbm(const char *path, void *framebuffer);
+
+#endif // GLIB_HOST_H
@@ -0,0 +1,18 @@
+/***************************************************************************//**
+ * @file
+ * @brief Monotonic nanosecond clock for the host tools
+ ******************************************************************************/
+
+#ifndef HOST_TIMER_H
+#define HOST_TIMER_H
+#include <stdint.h>
+#include <time.h>
+
+static inline uint64_t hostTimeNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+#endif // HOST_TIMER_H
@@ -0,0 +1,115 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host transport for lcdflush.c: a simulated memory LCD on a thread
+ ******************************************************************************/
+
+#include <string.h>
+#include <time.h>
+#include "lcd_host.h"
+#include "host_timer.h"
+
+// Applies a multi-line update command to the panel, checking its framing
+static bool decode(struct hostLcd *lcd, const uint8_t *data, size_t length)
+{
+    if (length < LCD_UPDATE_BYTES(1) || (length - 2) % (LCD_LINE_BYTES + 2) != 0 || data[0] != LCD_CMD_UPDATE ||
+        data[length - 1] != 0) {
+        return false;
+    }
+    for (const uint8_t *line = data + 1; line < data + length - 1; line += LCD_LINE_BYTES + 2) {
+        if (line[0] < 1 || line[0] > LCD_HEIGHT || line[LCD_LINE_BYTES + 1] != 0) {
+            return false;
+        }
+        memcpy(lcd->panel[line[0] - 1], line + 1, LCD_LINE_BYTES);
+    }
+    return true;
+}
+
+static void *worker(void *arg)
+{
+    struct hostLcd *lcd = arg;
+    pthread_mutex_lock(&lcd->lock);
+    while (!lcd->quit) {
+        if (lcd->data == NULL) {
+            pthread_cond_wait(&lcd->kick, &lcd->lock);
+            continue;
+        }
+        const uint8_t *data = lcd->data;
+        size_t length = lcd->length;
+        pthread_mutex_unlock(&lcd->lock);
+        if (lcd->bitRate > 0) {
+            uint64_t ns = (uint64_t)length * 8 * 1000000000u / lcd->bitRate;
+            struct timespec wire = {(time_t)(ns / 1000000000u), (long)(ns % 1000000000u)};
+            nanosleep(&wire, NULL);
+        }
+        if (!decode(lcd, data, length)) {
+            lcd->badCommands++;
+        }
+        pthread_mutex_lock(&lcd->lock);
+        lcd->data = NULL;
+        pthread_mutex_unlock(&lcd->lock);
+        lcdFlushDone(lcd->flush); // May start the next command through hostStart()
+        pthread_mutex_lock(&lcd->lock);
+    }
+    pthread_mutex_unlock(&lcd->lock);
+    return NULL;
+}
+
+static void hostStart(void *ctx, const uint8_t *data, size_t length)
+{
+    struct hostLcd *lcd = ctx;
+    pthread_mutex_lock(&lcd->lock);
+    lcd->data = data;
+    lcd->length = length;
+    pthread_cond_signal(&lcd->kick);
+    pthread_mutex_unlock(&lcd->lock);
+}
+
+static void hostWait(void *ctx)
+{
+    struct hostLcd *lcd = ctx;
+    sem_wait(&lcd->done);
+}
+
+static void hostWake(void *ctx)
+{
+    struct hostLcd *lcd = ctx;
+    sem_post(&lcd->done);
+}
+
+static uint32_t hostClock(void *ctx)
+{
+    (void)ctx;
+    return (uint32_t)hostTimeNs();
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Starts the simulated panel (all white, like a cleared LCD) and points
+ *   flush at it.
+ ******************************************************************************/
+void hostLcdInit(struct hostLcd *lcd, struct lcdFlush *flush, uint32_t bitRate)
+{
+    struct lcdTransport transport = {hostStart, hostWait, hostWake, hostClock, 1000000000u, lcd};
+    memset(lcd, 0, sizeof(*lcd));
+    memset(lcd->panel, 0xff, sizeof(lcd->panel));
+    lcd->flush = flush;
+    lcd->bitRate = bitRate;
+    lcdFlushInit(flush, &transport);
+    pthread_mutex_init(&lcd->lock, NULL);
+    pthread_cond_init(&lcd->kick, NULL);
+    sem_init(&lcd->done, 0, 0);
+    pthread_create(&lcd->thread, NULL, worker, lcd);
+}
+
+void hostLcdStop(struct hostLcd *lcd)
+{
+    lcdFlushWait(lcd->flush);
+    pthread_mutex_lock(&lcd->lock);
+    lcd->quit = true;
+    pthread_cond_signal(&lcd->kick);
+    pthread_mutex_unlock(&lcd->lock);
+    pthread_join(lcd->thread, NULL);
+    sem_destroy(&lcd->done);
+    pthread_cond_destroy(&lcd->kick);
+    pthread_mutex_destroy(&lcd->lock);
+}
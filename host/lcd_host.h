@@ -0,0 +1,36 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host transport for lcdflush.c: a simulated memory LCD on a thread
+ *******************************************************************************
+ * Stands in for the LDMA transport. A worker thread takes each update
+ * command, sleeps for as long as the SPI link would take to send it, decodes
+ * it into panel[] and reports lcdFlushDone(), as the TX complete interrupt
+ * does on the board. Waiting is on a POSIX semaphore, like the task's OS_SEM.
+ ******************************************************************************/
+
+#ifndef LCD_HOST_H
+#define LCD_HOST_H
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include "lcdflush.h"
+#include "lcdlines.h"
+
+struct hostLcd {
+    struct lcdFlush *flush;
+    uint32_t bitRate; // SPI clock in Hz; 0 completes at once
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t kick;
+    sem_t done;
+    const uint8_t *data; // command being sent, NULL when idle
+    size_t length;
+    bool quit;
+    uint8_t panel[LCD_HEIGHT][LCD_LINE_BYTES]; // what the simulated panel shows
+    uint32_t badCommands; // commands that did not decode
+};
+
+void hostLcdInit(struct hostLcd *lcd, struct lcdFlush *flush, uint32_t bitRate);
+void hostLcdStop(struct hostLcd *lcd);
+
+#endif // LCD_HOST_H
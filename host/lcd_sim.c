@@ -0,0 +1,160 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host check of the LCD flush path against a simulated panel
+ *******************************************************************************
+ * Runs the display task's flush path, lcdLinesUpdate() into one of two
+ * command buffers and lcdFlushStart(), over the threaded transport of
+ * lcd_host.c at the memory LCD's SPI rate.
+ * The scene is the static background plus boxes bouncing around it. After
+ * every wait the simulated panel must hold exactly what lcdLines believes it
+ * shows, which checks the update command framing and that no command buffer
+ * is reused while still in flight.
+ *
+ *   ./lcd_sim [-f frames] [-n boxes] [-p period ms] [-r SPI Hz] [-w compose us] [-1] [-s]
+ *
+ * -p 0 draws frames back to back, for the maximum frame rate. -w adds that
+ * much busy time to each frame's composition, standing in for the GLIB
+ * drawing the board does (a few ms), which the host does in microseconds.
+ * -1 uses a single command buffer, so each frame waits for the last one to
+ * be sent before its lines are copied. -s also waits for every transfer
+ * right after starting it, as the blocking driver did. Reports lines and
+ * bytes per frame, how long per frame the task is blocked in the flush and
+ * busy in total, the latency from the start of a frame to the end of its
+ * transfer and frames per second.
+ ******************************************************************************/
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "framebuf.h"
+#include "lcdflush.h"
+#include "lcdlines.h"
+#include "lcd_host.h"
+#include "host_timer.h"
+
+#define MAX_BOXES 32
+#define BOX_SIZE  6
+
+struct box {
+    int x, y, dx, dy;
+};
+
+static uint32_t framebuffer[FRAMEBUF_WORDS];
+static struct lcdLines lines;
+static struct lcdFlush flush;
+static struct hostLcd lcd;
+static uint8_t command[LCD_FLUSH_QUEUE][LCD_UPDATE_MAX_BYTES];
+static uint32_t commandTicket[LCD_FLUSH_QUEUE];
+
+// Black is a cleared bit on the memory LCD
+static void fillRect(int x0, int y0, int x1, int y1)
+{
+    uint8_t *fb = (uint8_t *)framebuffer;
+    for (int y = y0 < 0 ? 0 : y0; y <= y1 && y < LCD_HEIGHT; y++) {
+        for (int x = x0 < 0 ? 0 : x0; x <= x1 && x < LCD_WIDTH; x++) {
+            fb[y * LCD_LINE_BYTES + x / 8] &= (uint8_t)~(1u << (x % 8));
+        }
+    }
+}
+
+static void render(struct box *boxes, int count)
+{
+    memset(framebuffer, 0xff, sizeof(framebuffer));
+    fillRect(0, 0, 20, 90); // castle
+    fillRect(0, 90, 1, LCD_HEIGHT - 1); // cliff
+    fillRect(LCD_WIDTH - 2, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1); // right wall
+    for (int i = 0; i < count; i++) {
+        struct box *b = &boxes[i];
+        if (b->x + b->dx < 22 || b->x + b->dx + BOX_SIZE > LCD_WIDTH - 3) {
+            b->dx = -b->dx;
+        }
+        if (b->y + b->dy < 0 || b->y + b->dy + BOX_SIZE > LCD_HEIGHT) {
+            b->dy = -b->dy;
+        }
+        b->x += b->dx;
+        b->y += b->dy;
+        fillRect(b->x, b->y, b->x + BOX_SIZE - 1, b->y + BOX_SIZE - 1);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int frames = 60, count = 4, periodMs = 50;
+    uint32_t bitRate = 1100000;
+    bool sync = false;
+    int buffers = LCD_FLUSH_QUEUE;
+    int composeUs = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "f:n:p:r:w:1s")) != -1) {
+        switch (opt) {
+          case 'f': frames = atoi(optarg); break;
+          case 'n': count = atoi(optarg); break;
+          case 'p': periodMs = atoi(optarg); break;
+          case 'r': bitRate = (uint32_t)strtoul(optarg, NULL, 10); break;
+          case 'w': composeUs = atoi(optarg); break;
+          case '1': buffers = 1; break;
+          case 's': sync = true; break;
+          default:
+              fprintf(stderr, "usage: %s [-f frames] [-n boxes] [-p period ms] [-r SPI Hz] [-w compose us] [-1] [-s]\n", argv[0]);
+              return 2;
+        }
+    }
+    count = count < 0 ? 0 : (count > MAX_BOXES ? MAX_BOXES : count);
+    struct box boxes[MAX_BOXES];
+    srand(1);
+    for (int i = 0; i < count; i++) {
+        boxes[i] = (struct box){30 + rand() % 80, rand() % 110, 1 + rand() % 3, 1 + rand() % 3};
+    }
+
+    lcdLinesInit(&lines);
+    hostLcdInit(&lcd, &flush, bitRate);
+    uint64_t blockedNs = 0, busyNs = 0;
+    uint32_t mismatches = 0;
+    uint64_t first = hostTimeNs(), next = first;
+    int current = 0;
+    for (int f = 0; f < frames; f++) {
+        uint64_t start = hostTimeNs();
+        render(boxes, count);
+        while (hostTimeNs() - start < (uint64_t)composeUs * 1000u) {}
+        uint64_t waitStart = hostTimeNs();
+        lcdFlushWaitFor(&flush, commandTicket[current]);
+        blockedNs += hostTimeNs() - waitStart;
+        if (!lcdFlushBusy(&flush)) {
+            mismatches += memcmp(lcd.panel, lines.shown, sizeof(lcd.panel)) != 0 && lines.valid;
+        }
+        size_t length = lcdLinesUpdate(&lines, framebuffer, command[current]);
+        if (length > 0) {
+            commandTicket[current] = lcdFlushStart(&flush, command[current], length, (uint32_t)start);
+            current = (current + 1) % buffers;
+        }
+        if (sync) {
+            waitStart = hostTimeNs();
+            lcdFlushWait(&flush);
+            blockedNs += hostTimeNs() - waitStart;
+        }
+        busyNs += hostTimeNs() - start;
+        next += (uint64_t)periodMs * 1000000u;
+        uint64_t now = hostTimeNs();
+        if (next > now) {
+            struct timespec pause = {(time_t)((next - now) / 1000000000u), (long)((next - now) % 1000000000u)};
+            nanosleep(&pause, NULL);
+        }
+    }
+    hostLcdStop(&lcd);
+    double seconds = (hostTimeNs() - first) / 1e9;
+    mismatches += memcmp(lcd.panel, framebuffer, sizeof(lcd.panel)) != 0;
+
+    printf("%s flush, %d command buffer%s, %d frames of %d boxes every %d ms at %u Hz\n",
+           sync ? "blocking" : "async", buffers, buffers > 1 ? "s" : "", frames, count, periodMs, bitRate);
+    printf("lines     %.1f per frame, %u frames sent, %.0f bytes per frame\n",
+           (double)lines.stats.linesSent / frames, lines.stats.framesSent, (double)flush.stats.bytes / frames);
+    printf("task      %.3f ms busy per frame, %.3f ms of it blocked in the flush, %u waits\n",
+           busyNs / 1e6 / frames, blockedNs / 1e6 / frames, flush.stats.waits);
+    printf("frames    %.3f ms mean latency, %.3f ms max, %.1f frames/s\n",
+           flush.stats.transfers ? lcdFlushMicros(&flush, (uint32_t)(flush.stats.latencyTotal / flush.stats.transfers)) / 1e3 : 0.0,
+           lcdFlushMicros(&flush, flush.stats.latencyMax) / 1e3, flush.stats.transfers / seconds);
+    printf("panel     %u mismatches, %u bad commands\n", mismatches, lcd.badCommands);
+    return mismatches || lcd.badCommands ? 1 : 0;
+}
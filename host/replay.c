@@ -0,0 +1,70 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host replay of a recorded game
+ *******************************************************************************
+ * Plays a record exported by the recorder (on the board, from replayBuffer
+ * after physicsExportRecording(); on the host, from game_runner -o) through
+ * physicsStep() and checks the game ends the way the record says it did.
+ *
+ *   ./replay record.bin
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "game.h"
+#include "recorder.h"
+
+static struct gameState state;
+static uint8_t record[1 << 20];
+
+static void printOutcome(const char *label, const struct gameData *g)
+{
+    static const char *const names[] = {"menu", "active", "win", "fail"};
+    printf("%-9s %-6s damage %d, energy %ld J, charge %ld J, satchels %d (%d intercepted), "
+           "shots %d, shields %d (%d useful), evac %d\n",
+           label, g->state >= 0 && g->state <= fail ? names[g->state] : "?", g->foundationDamage,
+           (long)g->energy, (long)g->shotCharge, g->satchelsThrown, g->satchelsIntercepted,
+           g->shotsFired, g->shieldsActivated, g->usefulShields, g->evacComplete);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s record.bin\n", argv[0]);
+        return 2;
+    }
+    FILE *f = fopen(argv[1], "rb");
+    if (!f) {
+        perror(argv[1]);
+        return 2;
+    }
+    uint32_t length = (uint32_t)fread(record, 1, sizeof(record), f);
+    fclose(f);
+
+    struct replay rp;
+    struct physicsConstants consts;
+    struct gameInputs in;
+    struct gameData expected;
+    uint32_t seed;
+    if (!replayOpen(&rp, record, length, &seed, &consts)) {
+        fprintf(stderr, "%s: not a version %d record\n", argv[1], RECORDER_VERSION);
+        return 2;
+    }
+    uint32_t steps = rp.stepsLeft;
+    printf("record    %u bytes, seed %u, %u steps (%.1f s at %d ms)\n",
+           length, seed, steps, steps * consts.physicsPeriod / 1000.0, consts.physicsPeriod);
+    gameInit(&state, &consts, seed);
+    fix16_t dt = fix16FromFrac(consts.physicsPeriod, 1000);
+    while (replayNext(&rp, &in)) {
+        physicsStep(&state, &in, dt);
+    }
+    if (!replayOutcome(&rp, &expected)) {
+        fprintf(stderr, "%s: truncated record\n", argv[1]);
+        return 2;
+    }
+    printOutcome("recorded", &expected);
+    printOutcome("replayed", &state.game);
+    bool same = replaySameOutcome(&expected, &state.game);
+    printf("%s\n", same ? "MATCH" : "MISMATCH");
+    return same ? 0 : 1;
+}
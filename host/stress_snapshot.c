@@ -0,0 +1,180 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host stress test of the published physics snapshot
+ *******************************************************************************
+ * One writer thread publishes frames as fast as it can, as the physics task
+ * does, while reader threads copy them with snapshotRead() and
+ * snapshotReadGame() as the display and LED tasks do. Every field of the
+ * n-th published frame is derived from n alone, so a reader can tell from
+ * any copy whether it mixes two publishes: each one is checked in full, and
+ * must also be no older than the last one the same reader saw. Reports
+ * reads, retries and torn reads, and exits non-zero on any torn read.
+ *
+ *   ./stress_snapshot [-n publishes] [-r readers]
+ ******************************************************************************/
+
+#include <getopt.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snapshot.h"
+#include "host_timer.h"
+
+#define MAX_READERS 16
+
+struct reader {
+    pthread_t thread;
+    bool game; // snapshotReadGame() instead of snapshotRead()
+    uint64_t reads;
+    uint64_t torn;
+    uint64_t stale; // a publish older than one already seen
+};
+
+static struct frameSnapshot snap;
+static volatile bool done;
+
+static void frameObjects(uint32_t n, struct physicsData *objects, struct objectPosition *previous)
+{
+    for (int i = 0; i < PHYSICS_MAX_OBJECTS; i++) {
+        uint32_t v = n * PHYSICS_MAX_OBJECTS + (uint32_t)i;
+        objects[i].objectType = (uint8_t)(v % 4);
+        objects[i].mass = (uint16_t)v;
+        objects[i].x = (fix16_t)v;
+        objects[i].y = (fix16_t)~v;
+        objects[i].xVel = (fix16_t)(v * 3);
+        objects[i].yVel = (fix16_t)(v * 5);
+        objects[i].xForce = (int32_t)(v * 7);
+        objects[i].yForce = (int32_t)(v * 11);
+        previous[i].objectType = (uint8_t)(v % 4);
+        previous[i].x = (fix16_t)(v ^ 0x5a5a5a5a);
+        previous[i].y = (fix16_t)(v * 13);
+    }
+}
+
+static void frameGame(uint32_t n, struct gameData *game)
+{
+    memset(game, 0, sizeof(*game));
+    game->state = (int)(n % 4);
+    game->energy = (int32_t)n;
+    game->shotCharge = (int32_t)(n * 3);
+    game->foundationDamage = (int)(n % 1000);
+    game->evacComplete = n & 1;
+    game->shieldActive = n & 2;
+    game->satchelsThrown = (int)(n * 5);
+    game->satchelsIntercepted = (int)(n * 7);
+    game->shieldsActivated = (int)(n * 11);
+    game->usefulShields = (int)(n * 13);
+    game->shotsFired = (int)(n * 17);
+    game->profile = (int)(n % 5);
+}
+
+// Field by field, as struct assignment need not copy the padding
+static bool gameEqual(const struct gameData *a, const struct gameData *b)
+{
+    return a->state == b->state && a->energy == b->energy && a->shotCharge == b->shotCharge
+           && a->foundationDamage == b->foundationDamage && a->evacComplete == b->evacComplete
+           && a->shieldActive == b->shieldActive && a->satchelsThrown == b->satchelsThrown
+           && a->satchelsIntercepted == b->satchelsIntercepted && a->shieldsActivated == b->shieldsActivated
+           && a->usefulShields == b->usefulShields && a->shotsFired == b->shotsFired && a->profile == b->profile;
+}
+
+static bool gameIntact(const struct gameData *game, uint32_t published)
+{
+    struct gameData expected;
+    frameGame(published, &expected);
+    if (published == 0) {
+        memset(&expected, 0, sizeof(expected));
+    }
+    return gameEqual(game, &expected);
+}
+
+static bool frameIntact(const struct gameFrame *frame, uint32_t published)
+{
+    static __thread struct physicsData objects[PHYSICS_MAX_OBJECTS];
+    static __thread struct objectPosition previous[PHYSICS_MAX_OBJECTS];
+    uint32_t n = frame->tick;
+    if (n != published) {
+        return false;
+    }
+    if (n == 0) { // Nothing published yet: the zeroed initial frame
+        memset(objects, 0, sizeof(objects));
+        memset(previous, 0, sizeof(previous));
+    } else {
+        frameObjects(n, objects, previous);
+    }
+    return frame->stateTime == n && frame->stepTicks == n * 3 && gameIntact(&frame->game, n)
+           && memcmp(frame->objects, objects, sizeof(objects)) == 0 && memcmp(frame->previous, previous, sizeof(previous)) == 0;
+}
+
+static void *readerThread(void *arg)
+{
+    struct reader *r = arg;
+    static __thread struct gameFrame frame;
+    uint32_t last = 0;
+    while (!done) {
+        uint32_t published;
+        bool intact;
+        if (r->game) {
+            struct gameData game;
+            published = snapshotReadGame(&snap, &game);
+            intact = gameIntact(&game, published);
+        } else {
+            published = snapshotRead(&snap, &frame);
+            intact = frameIntact(&frame, published);
+        }
+        r->reads++;
+        r->torn += !intact;
+        r->stale += published < last;
+        last = published > last ? published : last;
+    }
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t publishes = 2000000;
+    int readers = 3;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:r:")) != -1) {
+        if (opt == 'n') {
+            publishes = (uint32_t)strtoul(optarg, NULL, 0);
+        } else if (opt == 'r') {
+            readers = atoi(optarg);
+            readers = readers < 1 ? 1 : readers > MAX_READERS ? MAX_READERS : readers;
+        } else {
+            fprintf(stderr, "usage: %s [-n publishes] [-r readers]\n", argv[0]);
+            return 2;
+        }
+    }
+    static struct physicsData objects[PHYSICS_MAX_OBJECTS];
+    static struct objectPosition previous[PHYSICS_MAX_OBJECTS];
+    static struct reader reader[MAX_READERS];
+    snapshotInit(&snap);
+    for (int i = 0; i < readers; i++) {
+        reader[i].game = i % 2 == 1;
+        pthread_create(&reader[i].thread, NULL, readerThread, &reader[i]);
+    }
+    uint64_t start = hostTimeNs();
+    for (uint32_t n = 1; n <= publishes; n++) {
+        struct gameData game;
+        frameObjects(n, objects, previous);
+        frameGame(n, &game);
+        snapshotPublish(&snap, objects, previous, &game, n, n * 3);
+    }
+    double seconds = (double)(hostTimeNs() - start) / 1e9;
+    done = true;
+    uint64_t reads = 0, torn = 0, stale = 0;
+    for (int i = 0; i < readers; i++) {
+        pthread_join(reader[i].thread, NULL);
+        printf("reader %d (%s): %llu reads, %llu torn, %llu stale\n", i, reader[i].game ? "game" : "frame",
+               (unsigned long long)reader[i].reads, (unsigned long long)reader[i].torn, (unsigned long long)reader[i].stale);
+        reads += reader[i].reads;
+        torn += reader[i].torn;
+        stale += reader[i].stale;
+    }
+    printf("%lu publishes in %.2f s, %llu reads, %lu retries, %llu torn, %llu stale\n", (unsigned long)publishes, seconds,
+           (unsigned long long)reads, (unsigned long)snap.readRetries, (unsigned long long)torn, (unsigned long long)stale);
+    return torn != 0 || stale != 0;
+}
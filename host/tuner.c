@@ -0,0 +1,416 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host Monte Carlo tuner for physicsConstants profiles
+ *******************************************************************************
+ * Sweeps up to four physicsConstants fields over a grid and plays many bot
+ * games at every point through libgame.a, spread over all cores. The base
+ * is one of the compile time profiles (-P, PHYSICS_VERSION's by default);
+ * swept values replace its screen scaled fields, so they are in the same
+ * units the engine sees.
+ *
+ *   ./tuner -f throwPeriod=5:40:5 -f shieldEffectiveRange=10,20,30 \
+ *           [-f limitingMethod=2] [-n games per point] [-p idle|random|defend]
+ *           [-t max seconds per game] [-j threads] [-s seed] [-P profile] [-x]
+ *
+ * Work is split into chunks of games. Each thread starts with an equal share
+ * of the chunks and takes from the front of its own range; when it runs dry it
+ * steals the back half of another thread's range, so points whose games run
+ * long do not leave cores idle. Every point plays the same seeds, so points
+ * differ only by their constants. -x repeats the sweep at 1, 2, 4 ... threads
+ * and prints the speedup.
+ ******************************************************************************/
+
+#include <getopt.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "game.h"
+#include "bot.h"
+#include "host_timer.h"
+
+#define MAX_FIELDS  4
+#define MAX_VALUES  64
+#define CHUNK_GAMES 8
+
+struct fieldInfo {
+    const char *name;
+    size_t offset;
+};
+
+#define FIELD(name, member) {name, offsetof(struct physicsConstants, member)}
+static const struct fieldInfo fields[] = {
+    FIELD("physicsPeriod", physicsPeriod),
+    FIELD("canyonSize", canyonSize),
+    FIELD("castleHeight", castleConst.castleHeight),
+    FIELD("foundationHitsRequired", castleConst.foundationHitsRequired),
+    FIELD("foundationDepth", castleConst.foundationDepth),
+    FIELD("limitingMethod", satchelConst.limitingMethod),
+    FIELD("satchelDisplayDiameter", satchelConst.satchelDisplayDiameter),
+    FIELD("throwPeriod", satchelConst.throwPeriod),
+    FIELD("maxInFlight", satchelConst.maxInFlight),
+    FIELD("maxInFlightPeriod", satchelConst.maxInFlightPeriod),
+    FIELD("satchelWeight", satchelConst.satchelWeight),
+    FIELD("maxPlatformForce", platformConst.maxPlatformForce),
+    FIELD("platformMass", platformConst.platformMass),
+    FIELD("platformLength", platformConst.platformLength),
+    FIELD("maxPlatformBounceSpeed", platformConst.maxPlatformBounceSpeed),
+    FIELD("maxPlatformSpeed", platformConst.maxPlatformSpeed),
+    FIELD("shieldEffectiveRange", shieldConst.shieldEffectiveRange),
+    FIELD("shieldActivationEnergy", shieldConst.shieldActivationEnergy),
+    FIELD("railgunAngle", railGunConst.railgunAngle),
+    FIELD("shotMass", railGunConst.shotMass),
+    FIELD("shotRadius", railGunConst.shotRadius),
+    FIELD("energyCapacity", generatorConst.energyCapacity),
+    FIELD("maxShotPower", generatorConst.maxShotPower),
+};
+#define FIELD_COUNT (sizeof(fields) / sizeof(fields[0]))
+
+struct sweep {
+    const struct fieldInfo *field;
+    int count;
+    int values[MAX_VALUES];
+};
+
+struct pointStats {
+    uint64_t outcomes[4]; // indexed by the states enum; active counts timeouts
+    uint64_t finishedTicks;
+    uint64_t ticks;
+};
+
+struct worker {
+    pthread_mutex_t lock;
+    uint32_t next; // first task of this worker's range
+    uint32_t end;
+    uint64_t steals;
+    uint64_t games;
+    int id;
+    pthread_t thread;
+    struct gameState state;
+};
+
+static struct sweep sweeps[MAX_FIELDS];
+static int sweepCount;
+static struct physicsConstants base;
+static struct pointStats *points;
+static int pointCount;
+static int gamesPerPoint = 200;
+static int chunksPerPoint;
+static enum botPolicy policy = botDefend;
+static int maxSeconds = 300; // per game; each point's tick limit follows from its physicsPeriod
+static uint32_t seed = GAME_DEFAULT_SEED;
+static struct worker *workers;
+static int workerCount;
+
+// Value of every swept field at a grid point, first field varying slowest
+static void pointConstants(int point, struct physicsConstants *consts)
+{
+    *consts = base;
+    for (int f = sweepCount - 1; f >= 0; f--) {
+        int value = sweeps[f].values[point % sweeps[f].count];
+        point /= sweeps[f].count;
+        memcpy((char *)consts + sweeps[f].field->offset, &value, sizeof(value));
+    }
+}
+
+static int pointValue(int point, int field)
+{
+    for (int f = sweepCount - 1; f > field; f--) {
+        point /= sweeps[f].count;
+    }
+    return sweeps[field].values[point % sweeps[field].count];
+}
+
+static void runTask(struct worker *w, uint32_t task)
+{
+    int point = (int)(task / chunksPerPoint);
+    int first = (int)(task % chunksPerPoint) * CHUNK_GAMES;
+    int last = first + CHUNK_GAMES < gamesPerPoint ? first + CHUNK_GAMES : gamesPerPoint;
+    struct physicsConstants consts;
+    struct pointStats local;
+    struct bot bot;
+    struct gameInputs in;
+    memset(&local, 0, sizeof(local));
+    pointConstants(point, &consts);
+    fix16_t dt = fix16FromFrac(consts.physicsPeriod, 1000);
+    uint32_t maxTicks = (uint32_t)maxSeconds * 1000u / (uint32_t)consts.physicsPeriod;
+    angle_t aim = angleFromDegrees(consts.railGunConst.railgunAngle);
+    for (int g = first; g < last; g++) {
+        gameInit(&w->state, &consts, seed + (uint32_t)g);
+        botInit(&bot, policy, seed + (uint32_t)g, aim);
+        uint32_t tick = 0;
+        while (w->state.game.state == active && tick < maxTicks) {
+            botInputs(&bot, &w->state, &in);
+            physicsStep(&w->state, &in, dt);
+            tick++;
+        }
+        local.outcomes[w->state.game.state]++;
+        local.ticks += tick;
+        if (w->state.game.state != active) {
+            local.finishedTicks += tick;
+        }
+    }
+    struct pointStats *p = &points[point];
+    for (int i = 0; i < 4; i++) {
+        __atomic_fetch_add(&p->outcomes[i], local.outcomes[i], __ATOMIC_RELAXED);
+    }
+    __atomic_fetch_add(&p->finishedTicks, local.finishedTicks, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&p->ticks, local.ticks, __ATOMIC_RELAXED);
+    w->games += (uint64_t)(last - first);
+}
+
+// Takes the back half of another worker's range. False when nobody has work left.
+static bool steal(struct worker *w)
+{
+    for (int k = 1; k < workerCount; k++) {
+        struct worker *victim = &workers[(w->id + k) % workerCount];
+        pthread_mutex_lock(&victim->lock);
+        uint32_t remaining = victim->end - victim->next;
+        if (remaining == 0) {
+            pthread_mutex_unlock(&victim->lock);
+            continue;
+        }
+        uint32_t end = victim->end;
+        uint32_t start = victim->next + remaining / 2;
+        victim->end = start;
+        pthread_mutex_unlock(&victim->lock);
+        pthread_mutex_lock(&w->lock);
+        w->next = start;
+        w->end = end;
+        pthread_mutex_unlock(&w->lock);
+        w->steals++;
+        return true;
+    }
+    return false;
+}
+
+static void *workerMain(void *arg)
+{
+    struct worker *w = arg;
+    for (;;) {
+        pthread_mutex_lock(&w->lock);
+        bool have = w->next < w->end;
+        uint32_t task = w->next;
+        if (have) {
+            w->next++;
+        }
+        pthread_mutex_unlock(&w->lock);
+        if (have) {
+            runTask(w, task);
+        } else if (!steal(w)) {
+            return NULL;
+        }
+    }
+}
+
+// Plays the whole grid on threads workers. Returns the wall time in seconds.
+static double runSweep(int threads, uint64_t *steals)
+{
+    uint32_t tasks = (uint32_t)(pointCount * chunksPerPoint);
+    memset(points, 0, sizeof(*points) * pointCount);
+    workerCount = threads;
+    for (int i = 0; i < threads; i++) {
+        struct worker *w = &workers[i];
+        pthread_mutex_init(&w->lock, NULL);
+        w->id = i;
+        w->next = (uint32_t)((uint64_t)tasks * i / threads);
+        w->end = (uint32_t)((uint64_t)tasks * (i + 1) / threads);
+        w->steals = 0;
+        w->games = 0;
+    }
+    uint64_t start = hostTimeNs();
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&workers[i].thread, NULL, workerMain, &workers[i]);
+    }
+    *steals = 0;
+    for (int i = 0; i < threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+        pthread_mutex_destroy(&workers[i].lock);
+        *steals += workers[i].steals;
+    }
+    return (double)(hostTimeNs() - start) / 1e9;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "usage: %s -f field=start:stop[:step] | -f field=v1,v2,... [-f ...]\n"
+                    "       [-n games per point] [-p idle|random|defend] [-t max seconds per game]\n"
+                    "       [-j threads] [-s seed] [-P profile] [-x]\nfields:", name);
+    for (unsigned i = 0; i < FIELD_COUNT; i++) {
+        fprintf(stderr, " %s", fields[i].name);
+    }
+    fprintf(stderr, "\n");
+    exit(2);
+}
+
+static void parseSweep(const char *name, const char *arg)
+{
+    char buf[128];
+    snprintf(buf, sizeof(buf), "%s", arg);
+    char *eq = strchr(buf, '=');
+    if (!eq || sweepCount == MAX_FIELDS) {
+        usage(name);
+    }
+    *eq = '\0';
+    struct sweep *s = &sweeps[sweepCount++];
+    for (unsigned i = 0; i < FIELD_COUNT; i++) {
+        if (!strcmp(buf, fields[i].name)) {
+            s->field = &fields[i];
+        }
+    }
+    if (!s->field) {
+        usage(name);
+    }
+    const char *spec = eq + 1;
+    int start, stop, step = 1;
+    if (strchr(spec, ':') && sscanf(spec, "%d:%d:%d", &start, &stop, &step) >= 2 && step > 0) {
+        for (int v = start; v <= stop && s->count < MAX_VALUES; v += step) {
+            s->values[s->count++] = v;
+        }
+    } else {
+        for (char *tok = strtok(eq + 1, ","); tok && s->count < MAX_VALUES; tok = strtok(NULL, ",")) {
+            s->values[s->count++] = atoi(tok);
+        }
+    }
+    if (s->count == 0) {
+        usage(name);
+    }
+    for (int i = 0; i < s->count; i++) {
+        if (s->field->offset == offsetof(struct physicsConstants, physicsPeriod) && s->values[i] <= 0) {
+            fprintf(stderr, "physicsPeriod must be positive, not %d\n", s->values[i]);
+            exit(2);
+        }
+    }
+}
+
+static double winRate(const struct pointStats *p)
+{
+    return 100.0 * p->outcomes[win] / gamesPerPoint;
+}
+
+// Seconds per physics tick at a grid point
+static double pointTickSeconds(int point)
+{
+    struct physicsConstants consts;
+    pointConstants(point, &consts);
+    return consts.physicsPeriod / 1000.0;
+}
+
+static double meanLength(const struct pointStats *p, double tickS)
+{
+    uint64_t finished = p->outcomes[win] + p->outcomes[fail];
+    return finished ? p->finishedTicks * tickS / finished : 0.0;
+}
+
+static void printMatrix(const char *title, double (*metric)(const struct pointStats *, double))
+{
+    printf("\n%s (rows %s, columns %s)\n%10s", title, sweeps[0].field->name, sweeps[1].field->name, "");
+    for (int c = 0; c < sweeps[1].count; c++) {
+        printf(" %8d", sweeps[1].values[c]);
+    }
+    printf("\n");
+    for (int r = 0; r < sweeps[0].count; r++) {
+        printf("%10d", sweeps[0].values[r]);
+        for (int c = 0; c < sweeps[1].count; c++) {
+            int point = r * sweeps[1].count + c;
+            printf(" %8.1f", metric(&points[point], pointTickSeconds(point)));
+        }
+        printf("\n");
+    }
+}
+
+static double winRateMetric(const struct pointStats *p, double tickS)
+{
+    (void)tickS;
+    return winRate(p);
+}
+
+int main(int argc, char **argv)
+{
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    bool scaling = false;
+    int profile = PHYSICS_DEFAULT_PROFILE;
+    int opt;
+    while ((opt = getopt(argc, argv, "f:n:p:t:j:s:P:x")) != -1) {
+        switch (opt) {
+          case 'f': parseSweep(argv[0], optarg); break;
+          case 'n': gamesPerPoint = atoi(optarg); break;
+          case 't': maxSeconds = atoi(optarg); break;
+          case 'j': threads = atoi(optarg); break;
+          case 's': seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+          case 'x': scaling = true; break;
+          case 'P':
+              if ((profile = physicsProfileFromName(optarg)) < 0) {
+                  usage(argv[0]);
+              }
+              break;
+          case 'p':
+              if (!botPolicyFromName(optarg, &policy)) {
+                  usage(argv[0]);
+              }
+              break;
+          default:
+              usage(argv[0]);
+        }
+    }
+    if (sweepCount == 0 || gamesPerPoint <= 0 || maxSeconds <= 0 || threads <= 0) {
+        usage(argv[0]);
+    }
+    base = physicsProfiles[profile].consts;
+    pointCount = 1;
+    for (int f = 0; f < sweepCount; f++) {
+        pointCount *= sweeps[f].count;
+    }
+    chunksPerPoint = (gamesPerPoint + CHUNK_GAMES - 1) / CHUNK_GAMES;
+    points = calloc((size_t)pointCount, sizeof(*points));
+    workers = calloc((size_t)threads, sizeof(*workers));
+    if (!points || !workers) {
+        perror("calloc");
+        return 1;
+    }
+
+    uint64_t games = (uint64_t)pointCount * gamesPerPoint;
+    uint64_t steals;
+    if (scaling) {
+        double single = 0;
+        printf("threads  seconds  speedup  efficiency  steals\n");
+        for (int t = 1; ; t = t * 2 < threads ? t * 2 : threads) {
+            double s = runSweep(t, &steals);
+            if (t == 1) {
+                single = s;
+            }
+            printf("%7d  %7.2f  %7.2f  %9.0f%%  %6llu\n", t, s, single / s, 100.0 * single / s / t,
+                   (unsigned long long)steals);
+            if (t == threads) {
+                break;
+            }
+        }
+    }
+    double seconds = runSweep(threads, &steals);
+    printf("%d points x %d games = %llu games on %d threads in %.2f s (%.0f games/s, %llu steals)\n",
+           pointCount, gamesPerPoint, (unsigned long long)games, threads, seconds, games / seconds,
+           (unsigned long long)steals);
+
+    for (int f = 0; f < sweepCount; f++) {
+        printf("%22s ", sweeps[f].field->name);
+    }
+    printf("   win%%   fail%%  timeout%%  length s\n");
+    for (int p = 0; p < pointCount; p++) {
+        for (int f = 0; f < sweepCount; f++) {
+            printf("%22d ", pointValue(p, f));
+        }
+        printf(" %6.1f  %6.1f  %8.1f  %8.1f\n", winRate(&points[p]),
+               100.0 * points[p].outcomes[fail] / gamesPerPoint,
+               100.0 * points[p].outcomes[active] / gamesPerPoint,
+               meanLength(&points[p], pointTickSeconds(p)));
+    }
+    if (sweepCount == 2) {
+        printMatrix("win rate %", winRateMetric);
+        printMatrix("mean game length s", meanLength);
+    }
+    free(points);
+    free(workers);
+    return 0;
+}
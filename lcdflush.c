@@ -0,0 +1,127 @@
+/***************************************************************************//**
+ * @file
+ * @brief Asynchronous LCD flush over a pluggable transport
+ ******************************************************************************/
+
+#include <string.h>
+#include "lcdflush.h"
+
+// The task queues and the transport's completion dequeues, possibly from an interrupt.
+// Only whoever wins transportBusy touches started or calls transport.start().
+
+void lcdFlushInit(struct lcdFlush *flush, const struct lcdTransport *transport)
+{
+    memset(flush, 0, sizeof(*flush));
+    flush->transport = *transport;
+    flush->stats.windowStart = lcdFlushClock(flush);
+}
+
+uint32_t lcdFlushClock(const struct lcdFlush *flush)
+{
+    return flush->transport.clock(flush->transport.ctx);
+}
+
+// Clock ticks to microseconds
+uint32_t lcdFlushMicros(const struct lcdFlush *flush, uint32_t ticks)
+{
+    return (uint32_t)((uint64_t)ticks * 1000000u / flush->transport.clockHz);
+}
+
+bool lcdFlushBusy(const struct lcdFlush *flush)
+{
+    return __atomic_load_n(&flush->completed, __ATOMIC_ACQUIRE) != flush->queued;
+}
+
+bool lcdFlushTicketDone(const struct lcdFlush *flush, uint32_t ticket)
+{
+    return (int32_t)(__atomic_load_n(&flush->completed, __ATOMIC_ACQUIRE) - ticket) >= 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Blocks until the transfer lcdFlushStart() returned ticket for is done.
+ ******************************************************************************/
+void lcdFlushWaitFor(struct lcdFlush *flush, uint32_t ticket)
+{
+    if (!lcdFlushTicketDone(flush, ticket)) {
+        flush->stats.waits++;
+    }
+    // Wakeups left over from transfers nobody waited for end up here as early returns
+    while (!lcdFlushTicketDone(flush, ticket)) {
+        flush->transport.wait(flush->transport.ctx);
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Blocks until nothing is queued or in flight.
+ ******************************************************************************/
+void lcdFlushWait(struct lcdFlush *flush)
+{
+    lcdFlushWaitFor(flush, flush->queued);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Hands the next queued command to the transport if it is idle.
+ ******************************************************************************/
+static void kick(struct lcdFlush *flush)
+{
+    while (__atomic_load_n(&flush->queued, __ATOMIC_ACQUIRE) != flush->started &&
+           !__atomic_exchange_n(&flush->transportBusy, 1, __ATOMIC_ACQUIRE)) {
+        if (__atomic_load_n(&flush->queued, __ATOMIC_ACQUIRE) != flush->started) {
+            unsigned slot = flush->started % LCD_FLUSH_QUEUE;
+            flush->started++;
+            flush->transport.start(flush->transport.ctx, flush->queue[slot].data, flush->queue[slot].length);
+            return;
+        }
+        // Lost a race with the other side emptying the queue; let go and look again
+        __atomic_store_n(&flush->transportBusy, 0, __ATOMIC_RELEASE);
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Queues data for sending and returns its ticket. Waits only when the
+ *   queue is full. stamp is the lcdFlushClock() time the frame began, for
+ *   the latency stats. data must not change until the ticket is done.
+ ******************************************************************************/
+uint32_t lcdFlushStart(struct lcdFlush *flush, const uint8_t *data, size_t length, uint32_t stamp)
+{
+    lcdFlushWaitFor(flush, flush->queued - LCD_FLUSH_QUEUE + 1);
+    unsigned slot = flush->queued % LCD_FLUSH_QUEUE;
+    flush->queue[slot].data = data;
+    flush->queue[slot].length = length;
+    flush->queue[slot].stamp = stamp;
+    flush->stats.transfers++;
+    flush->stats.bytes += (uint32_t)length;
+    __atomic_store_n(&flush->queued, flush->queued + 1, __ATOMIC_RELEASE);
+    kick(flush);
+    return flush->queued;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Called by the transport when the current transfer has completed.
+ ******************************************************************************/
+void lcdFlushDone(struct lcdFlush *flush)
+{
+    struct lcdFlushStats *stats = &flush->stats;
+    uint32_t now = lcdFlushClock(flush);
+    uint32_t done = __atomic_load_n(&flush->completed, __ATOMIC_RELAXED);
+    uint32_t latency = now - flush->queue[done % LCD_FLUSH_QUEUE].stamp;
+    stats->latencyLast = latency;
+    stats->latencyMax = latency > stats->latencyMax ? latency : stats->latencyMax;
+    stats->latencyTotal += latency;
+    stats->windowFrames++;
+    if (now - stats->windowStart >= flush->transport.clockHz) {
+        stats->framesPerSecond = (uint32_t)((uint64_t)stats->windowFrames * flush->transport.clockHz /
+                                            (now - stats->windowStart));
+        stats->windowFrames = 0;
+        stats->windowStart = now;
+    }
+    __atomic_store_n(&flush->completed, done + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&flush->transportBusy, 0, __ATOMIC_RELEASE);
+    kick(flush);
+    flush->transport.wake(flush->transport.ctx);
+}
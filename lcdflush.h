@@ -0,0 +1,75 @@
+/***************************************************************************//**
+ * @file
+ * @brief Asynchronous LCD flush over a pluggable transport
+ *******************************************************************************
+ * lcdFlushStart() queues an update command and returns while it is still
+ * being sent. The transport calls lcdFlushDone() when the last byte is out,
+ * usually from an interrupt; that starts the next queued command and wakes
+ * anyone in lcdFlushWait(). Up to LCD_FLUSH_QUEUE commands can be queued, so
+ * with as many command buffers the next frame is composed while the last
+ * one is on the wire. A command buffer must stay untouched until its ticket
+ * (the lcdFlushStart() return value) is done; lcdFlushWaitFor() waits for it.
+ *
+ * On the board the transport is LDMA into the memlcd USART (lcdspi.c) and
+ * waiting pends on a semaphore; host/lcd_host.c sends to a simulated panel
+ * from a thread.
+ *
+ * The stats time each frame from the stamp given to lcdFlushStart(), taken
+ * with lcdFlushClock() when its composition began, to the end of its
+ * transfer, and count completed frames per second.
+ ******************************************************************************/
+
+#ifndef LCDFLUSH_H
+#define LCDFLUSH_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define LCD_FLUSH_QUEUE 2
+
+struct lcdTransport {
+    void (*start)(void *ctx, const uint8_t *data, size_t length); // begin sending and return
+    void (*wait)(void *ctx); // block until woken by wake(); may return early
+    void (*wake)(void *ctx); // called by lcdFlushDone(), possibly in an interrupt
+    uint32_t (*clock)(void *ctx); // free running, clockHz
+    uint32_t clockHz;
+    void *ctx;
+};
+
+struct lcdFlushStats {
+    uint32_t transfers;
+    uint32_t bytes;
+    uint32_t waits; // times a caller had to wait for a transfer
+    uint32_t latencyLast; // clock ticks from composition start to the end of the transfer
+    uint32_t latencyMax;
+    uint64_t latencyTotal; // over transfers, for the mean
+    uint32_t windowStart; // clock at the start of the current second
+    uint32_t windowFrames;
+    uint32_t framesPerSecond; // transfers completed over the last full second
+};
+
+struct lcdFlush {
+    struct lcdTransport transport;
+    struct {
+        const uint8_t *data;
+        size_t length;
+        uint32_t stamp;
+    } queue[LCD_FLUSH_QUEUE];
+    uint32_t queued; // transfers handed to lcdFlushStart()
+    uint32_t started; // transfers handed to the transport
+    uint32_t completed; // transfers lcdFlushDone() reported; equal to queued when idle
+    uint8_t transportBusy; // owned by whoever set it: a transfer is in flight or being started
+    struct lcdFlushStats stats;
+};
+
+void lcdFlushInit(struct lcdFlush *flush, const struct lcdTransport *transport);
+uint32_t lcdFlushClock(const struct lcdFlush *flush);
+uint32_t lcdFlushMicros(const struct lcdFlush *flush, uint32_t ticks);
+bool lcdFlushBusy(const struct lcdFlush *flush);
+bool lcdFlushTicketDone(const struct lcdFlush *flush, uint32_t ticket);
+void lcdFlushWaitFor(struct lcdFlush *flush, uint32_t ticket);
+void lcdFlushWait(struct lcdFlush *flush);
+uint32_t lcdFlushStart(struct lcdFlush *flush, const uint8_t *data, size_t length, uint32_t stamp);
+void lcdFlushDone(struct lcdFlush *flush);
+
+#endif // LCDFLUSH_H
@@ -0,0 +1,58 @@
+/***************************************************************************//**
+ * @file
+ * @brief Dirty-line tracking for the Sharp memory LCD
+ ******************************************************************************/
+
+#include <string.h>
+#include "lcdlines.h"
+
+void lcdLinesInit(struct lcdLines *lines)
+{
+    memset(lines, 0, sizeof(*lines));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Forgets what the panel shows, so the next update sends every line. For
+ *   when something other than lcdLinesUpdate() wrote the panel.
+ ******************************************************************************/
+void lcdLinesInvalidate(struct lcdLines *lines)
+{
+    lines->valid = false;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Builds the update command for the lines of framebuffer that differ from
+ *   the panel into command (LCD_UPDATE_MAX_BYTES) and takes them as shown.
+ *   Returns the command length, 0 when no line changed.
+ ******************************************************************************/
+size_t lcdLinesUpdate(struct lcdLines *lines, const void *framebuffer, uint8_t *command)
+{
+    const uint8_t *line = framebuffer;
+    uint8_t *out = command + 1;
+    uint32_t sent = 0;
+    for (int row = 0; row < LCD_HEIGHT; row++, line += LCD_LINE_BYTES) {
+        if (lines->valid && memcmp(lines->shown[row], line, LCD_LINE_BYTES) == 0) {
+            continue;
+        }
+        memcpy(lines->shown[row], line, LCD_LINE_BYTES);
+        *out++ = (uint8_t)(row + 1); // panel lines are numbered from 1
+        memcpy(out, line, LCD_LINE_BYTES);
+        out += LCD_LINE_BYTES;
+        *out++ = 0;
+        sent++;
+    }
+    lines->valid = true;
+    lines->stats.frames++;
+    lines->stats.lastLinesSent = sent;
+    if (sent == 0) {
+        return 0;
+    }
+    command[0] = LCD_CMD_UPDATE;
+    *out++ = 0;
+    lines->stats.framesSent++;
+    lines->stats.linesSent += sent;
+    lines->stats.bytesSent += (uint32_t)(out - command);
+    return (size_t)(out - command);
+}
@@ -0,0 +1,45 @@
+/***************************************************************************//**
+ * @file
+ * @brief Dirty-line tracking for the Sharp memory LCD
+ *******************************************************************************
+ * The memory LCD is written a line at a time, each line carrying its own
+ * address, so one transfer can update any set of lines. lcdLinesUpdate()
+ * compares the rendered framebuffer with the copy of what the panel last
+ * received and builds a single multi-line update command holding only the
+ * lines that differ. A frame where nothing moved sends nothing at all.
+ *
+ * The framebuffer layout (framebuf.h) is the DMD one, and its bit order is
+ * also the panel's wire order.
+ ******************************************************************************/
+
+#ifndef LCDLINES_H
+#define LCDLINES_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "framebuf.h"
+
+// Update command: mode byte, then address, data and a dummy byte per line, then a closing dummy byte
+#define LCD_CMD_UPDATE        0x01
+#define LCD_UPDATE_BYTES(lines) (2 + (lines) * (LCD_LINE_BYTES + 2))
+#define LCD_UPDATE_MAX_BYTES  LCD_UPDATE_BYTES(LCD_HEIGHT)
+
+struct lcdLineStats {
+    uint32_t frames; // lcdLinesUpdate() calls
+    uint32_t framesSent; // frames with at least one changed line
+    uint32_t lastLinesSent; // lines in the latest frame
+    uint32_t linesSent; // lines over all frames
+    uint32_t bytesSent; // update command bytes over all frames
+};
+
+struct lcdLines {
+    uint8_t shown[LCD_HEIGHT][LCD_LINE_BYTES]; // what the panel holds
+    bool valid; // false until a full frame went out; shown is then meaningless
+    struct lcdLineStats stats;
+};
+
+void lcdLinesInit(struct lcdLines *lines);
+void lcdLinesInvalidate(struct lcdLines *lines);
+size_t lcdLinesUpdate(struct lcdLines *lines, const void *framebuffer, uint8_t *command);
+
+#endif // LCDLINES_H
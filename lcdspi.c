@@ -0,0 +1,104 @@
+/***************************************************************************//**
+ * @file
+ * @brief LDMA transport for the memory LCD on the memlcd USART
+ ******************************************************************************/
+
+#include "em_cmu.h"
+#include "em_gpio.h"
+#include "em_ldma.h"
+#include "em_usart.h"
+#include "sl_memlcd_usart_config.h"
+#include "lcdspi.h"
+
+#if SL_MEMLCD_SPI_PERIPHERAL_NO != 1
+#error "lcdspi.c handles the USART1 interrupt and LDMA signal only"
+#endif
+
+#define LCD_SCS_SETUP_US 6 // chip select to first clock, LS013B7DH03 datasheet
+#define LCD_SCS_HOLD_US  2 // last clock to chip select release
+#define LCD_DMA_MAX_XFER 2048 // LDMA XFERCNT limit per descriptor; a full frame needs two
+
+static struct lcdFlush *lcdSpiFlush;
+static LDMA_Descriptor_t lcdSpiDescriptors[2];
+
+/***************************************************************************//**
+ * @brief
+ *   Busy waits about us microseconds. Only for the chip select timings.
+ ******************************************************************************/
+static void lcdDelayUs(uint32_t us)
+{
+    for (volatile uint32_t i = us * (SystemCoreClock / 4000000u); i > 0; i--) {}
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Sets up the LDMA, the interrupts and the cycle counter. Call after the
+ *   memlcd driver has initialized the USART, and before lcdFlushInit().
+ ******************************************************************************/
+void lcdSpiInit(struct lcdFlush *flush)
+{
+    LDMA_Init_t init = LDMA_INIT_DEFAULT;
+    lcdSpiFlush = flush;
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    CMU_ClockEnable(cmuClock_LDMA, true);
+    LDMA_Init(&init);
+    USART_IntDisable(SL_MEMLCD_SPI_PERIPHERAL, USART_IEN_TXC);
+    NVIC_ClearPendingIRQ(USART1_TX_IRQn);
+    NVIC_EnableIRQ(USART1_TX_IRQn);
+}
+
+uint32_t lcdSpiClock(void *ctx)
+{
+    (void)ctx;
+    return DWT->CYCCNT;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Asserts chip select and starts the LDMA. Returns before the transfer is
+ *   done; lcdFlushStart() makes sure the previous one is.
+ ******************************************************************************/
+void lcdSpiStart(void *ctx, const uint8_t *data, size_t length)
+{
+    (void)ctx;
+    LDMA_TransferCfg_t config = LDMA_TRANSFER_CFG_PERIPHERAL(ldmaPeripheralSignal_USART1_TXBL);
+    size_t first = length > LCD_DMA_MAX_XFER ? LCD_DMA_MAX_XFER : length;
+    if (first < length) {
+        lcdSpiDescriptors[0] = (LDMA_Descriptor_t)LDMA_DESCRIPTOR_LINKREL_M2P_BYTE(data, &SL_MEMLCD_SPI_PERIPHERAL->TXDATA, first, 1);
+        lcdSpiDescriptors[1] = (LDMA_Descriptor_t)LDMA_DESCRIPTOR_SINGLE_M2P_BYTE(data + first, &SL_MEMLCD_SPI_PERIPHERAL->TXDATA, length - first);
+    } else {
+        lcdSpiDescriptors[0] = (LDMA_Descriptor_t)LDMA_DESCRIPTOR_SINGLE_M2P_BYTE(data, &SL_MEMLCD_SPI_PERIPHERAL->TXDATA, length);
+    }
+    USART_IntClear(SL_MEMLCD_SPI_PERIPHERAL, USART_IFC_TXC);
+    GPIO_PinOutSet(SL_MEMLCD_SPI_CS_PORT, SL_MEMLCD_SPI_CS_PIN);
+    lcdDelayUs(LCD_SCS_SETUP_US);
+    LDMA_StartTransfer(LCD_SPI_DMA_CHANNEL, &config, lcdSpiDescriptors);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   LDMA has written the last byte to TXDATA; wait for it to be shifted out.
+ ******************************************************************************/
+void LDMA_IRQHandler(void)
+{
+    uint32_t pending = LDMA_IntGetEnabled();
+    if (pending & (1u << LCD_SPI_DMA_CHANNEL)) {
+        LDMA_IntClear(1u << LCD_SPI_DMA_CHANNEL);
+        USART_IntEnable(SL_MEMLCD_SPI_PERIPHERAL, USART_IEN_TXC);
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   The update command is out: release chip select and report completion.
+ ******************************************************************************/
+void USART1_TX_IRQHandler(void)
+{
+    USART_IntDisable(SL_MEMLCD_SPI_PERIPHERAL, USART_IEN_TXC);
+    USART_IntClear(SL_MEMLCD_SPI_PERIPHERAL, USART_IFC_TXC);
+    lcdDelayUs(LCD_SCS_HOLD_US);
+    GPIO_PinOutClear(SL_MEMLCD_SPI_CS_PORT, SL_MEMLCD_SPI_CS_PIN);
+    SL_MEMLCD_SPI_PERIPHERAL->CMD = USART_CMD_CLEARRX; // Nothing to read back from the panel
+    lcdFlushDone(lcdSpiFlush);
+}
@@ -0,0 +1,25 @@
+/***************************************************************************//**
+ * @file
+ * @brief LDMA transport for the memory LCD on the memlcd USART
+ *******************************************************************************
+ * Streams an update command from memory into SL_MEMLCD_SPI_PERIPHERAL's
+ * TXDATA on LDMA, paced by TXBL, while the CPU does something else. The LDMA
+ * done interrupt arms the USART TX complete interrupt, which releases chip
+ * select once the last bit has left and reports lcdFlushDone(). Board only;
+ * the USART itself is set up by the sl_memlcd driver. lcdSpiClock() is the
+ * DWT cycle counter, at SystemCoreClockGet() Hz.
+ ******************************************************************************/
+
+#ifndef LCDSPI_H
+#define LCDSPI_H
+#include <stddef.h>
+#include <stdint.h>
+#include "lcdflush.h"
+
+#define LCD_SPI_DMA_CHANNEL 0
+
+void lcdSpiInit(struct lcdFlush *flush);
+void lcdSpiStart(void *ctx, const uint8_t *data, size_t length);
+uint32_t lcdSpiClock(void *ctx);
+
+#endif // LCDSPI_H
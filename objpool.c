@@ -0,0 +1,82 @@
+/***************************************************************************//**
+ * @file
+ * @brief Fixed capacity object pool with per-type live lists
+ ******************************************************************************/
+
+#include <string.h>
+#include "objpool.h"
+
+static void listPush(struct objectPool *pool, uint8_t type, poolIndex_t index)
+{
+    poolIndex_t head = pool->head[type];
+    pool->prev[index] = POOL_NONE;
+    pool->next[index] = head;
+    if (head != POOL_NONE) {
+        pool->prev[head] = index;
+    }
+    pool->head[type] = index;
+    pool->count[type]++;
+}
+
+static void listRemove(struct objectPool *pool, uint8_t type, poolIndex_t index)
+{
+    poolIndex_t prev = pool->prev[index];
+    poolIndex_t next = pool->next[index];
+    if (prev != POOL_NONE) {
+        pool->next[prev] = next;
+    } else {
+        pool->head[type] = next;
+    }
+    if (next != POOL_NONE) {
+        pool->prev[next] = prev;
+    }
+    pool->count[type]--;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Empties every slot. The first allocation afterwards returns index 0.
+ ******************************************************************************/
+void poolInit(struct objectPool *pool, struct physicsData *objects)
+{
+    pool->objects = objects;
+    memset(objects, 0, sizeof(struct physicsData) * PHYSICS_MAX_OBJECTS);
+    for (int type = 0; type < POOL_TYPE_COUNT; type++) {
+        pool->head[type] = POOL_NONE;
+        pool->count[type] = 0;
+    }
+    for (int i = PHYSICS_MAX_OBJECTS - 1; i >= 0; i--) {
+        listPush(pool, empty, (poolIndex_t)i);
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Takes a free slot and moves it to the list for type. Returns POOL_NONE when full.
+ ******************************************************************************/
+poolIndex_t poolAlloc(struct objectPool *pool, uint8_t type)
+{
+    poolIndex_t index = pool->head[empty];
+    if (index == POOL_NONE) {
+        return POOL_NONE;
+    }
+    listRemove(pool, empty, index);
+    listPush(pool, type, index);
+    pool->objects[index].objectType = type;
+    return index;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Clears a slot and returns it to the free list.
+ ******************************************************************************/
+void poolFree(struct objectPool *pool, poolIndex_t index)
+{
+    struct physicsData *obj = &pool->objects[index];
+    if (obj->objectType == empty) {
+        return;
+    }
+    listRemove(pool, obj->objectType, index);
+    memset(obj, 0, sizeof(*obj));
+    listPush(pool, empty, index);
+}
@@ -0,0 +1,51 @@
+/***************************************************************************//**
+ * @file
+ * @brief Fixed capacity object pool with per-type live lists
+ *******************************************************************************
+ * Every slot of the backing physicsData array sits on exactly one doubly
+ * linked list: the free list (objectType empty) or the list for its type.
+ * Spawning, destroying and counting are O(1), and the physics tick walks only
+ * the lists it needs, so raising PHYSICS_MAX_OBJECTS does not add per-tick
+ * work. Links live beside the objects so the published snapshot stays compact.
+ ******************************************************************************/
+
+#ifndef OBJPOOL_H
+#define OBJPOOL_H
+#include <stdint.h>
+#include "physics.h"
+
+#define POOL_NONE       0xFFFFu
+#define POOL_TYPE_COUNT 4 // empty, player, satchel, shot
+
+typedef uint16_t poolIndex_t;
+
+struct objectPool {
+    struct physicsData *objects;
+    poolIndex_t next[PHYSICS_MAX_OBJECTS];
+    poolIndex_t prev[PHYSICS_MAX_OBJECTS];
+    poolIndex_t head[POOL_TYPE_COUNT];
+    uint16_t count[POOL_TYPE_COUNT];
+};
+
+void poolInit(struct objectPool *pool, struct physicsData *objects);
+poolIndex_t poolAlloc(struct objectPool *pool, uint8_t type);
+void poolFree(struct objectPool *pool, poolIndex_t index);
+
+static inline uint16_t poolCount(const struct objectPool *pool, uint8_t type)
+{
+    return pool->count[type];
+}
+
+// Iterate with: for (i = poolFirst(p, t); i != POOL_NONE; i = next) { next = poolNext(p, i); ... }
+// Fetch next before calling poolFree() on i.
+static inline poolIndex_t poolFirst(const struct objectPool *pool, uint8_t type)
+{
+    return pool->head[type];
+}
+
+static inline poolIndex_t poolNext(const struct objectPool *pool, poolIndex_t index)
+{
+    return pool->next[index];
+}
+
+#endif // OBJPOOL_H
@@ -0,0 +1,70 @@
+/***************************************************************************//**
+ * @file
+ * @brief On-screen performance HUD
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "perfhud.h"
+
+int perfHudHeight(const struct perfHudSample *sample)
+{
+    return (4 + sample->tasks) * 8;
+}
+
+// Rasterizes one line of text, blank past its end, into the eight rows at rows
+static void drawLine(uint32_t *rows, int line, const char *text)
+{
+    const GLIB_Font_t *font = &GLIB_FontNarrow6x8;
+    const uint8_t *pixMap = font->pFontPixMap;
+    const uint32_t glyphMask = (1u << font->fontWidth) - 1;
+    size_t length = strlen(text);
+    rows += line * font->fontHeight * PERF_HUD_WORDS;
+    for (int y = 0; y < font->fontHeight; y++, rows += PERF_HUD_WORDS) {
+        for (int w = 0; w < PERF_HUD_WORDS; w++) {
+            rows[w] = 0xffffffffu;
+        }
+        for (int column = 0; column < PERF_HUD_COLUMNS && (size_t)column < length; column++) {
+            int index = text[column] - ' ';
+            if (index <= 0 || index >= font->fontRowOffset) {
+                continue; // Spaces, and characters the font does not have, stay blank
+            }
+            uint32_t ink = pixMap[index + y * font->fontRowOffset] & glyphMask;
+            int x = column * font->fontWidth;
+            rows[x / 32] &= ~(ink << (x % 32));
+            if (x % 32 + font->fontWidth > 32) {
+                rows[x / 32 + 1] &= ~(ink >> (32 - x % 32));
+            }
+        }
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Rasterizes the sample into perfHudHeight() rows of PERF_HUD_WORDS:
+ *
+ *     cpu 12.3%  30fps
+ *     step     145us
+ *     frame    812us
+ *     task cpu%    stk
+ *     phys  3.2    142
+ *     ...
+ ******************************************************************************/
+void perfHudDraw(uint32_t *rows, const struct perfHudSample *sample)
+{
+    char text[32];
+    snprintf(text, sizeof(text), "cpu%3u.%u%% %3lufps", sample->cpu / 100u, sample->cpu % 100u / 10u,
+             (unsigned long)sample->rate);
+    drawLine(rows, 0, text);
+    snprintf(text, sizeof(text), "step  %6luus", (unsigned long)sample->stepMicros);
+    drawLine(rows, 1, text);
+    snprintf(text, sizeof(text), "frame %6luus", (unsigned long)sample->frameMicros);
+    drawLine(rows, 2, text);
+    drawLine(rows, 3, "task cpu%    stk");
+    for (int i = 0; i < sample->tasks; i++) {
+        const struct perfHudTask *task = &sample->task[i];
+        snprintf(text, sizeof(text), "%-4s%3u.%u %6lu", task->name, task->cpu / 100u, task->cpu % 100u / 10u,
+                 (unsigned long)task->stackFree);
+        drawLine(rows, 4 + i, text);
+    }
+}
@@ -0,0 +1,46 @@
+/***************************************************************************//**
+ * @file
+ * @brief On-screen performance HUD
+ *******************************************************************************
+ * A panel in the top left corner of the screen with total CPU usage and the
+ * display rate, the mean physics step and the latest frame time, and per
+ * task CPU usage and stack headroom. The display task fills a
+ * perfHudSample from Micrium's task statistics a couple of times a second.
+ * perfHudDraw() rasterizes it, black on white in GLIB's 6x8 font, into rows
+ * laid out as the framebuffer's but PERF_HUD_WORDS wide, a row of glyphs at
+ * a time rather than pixel by pixel as GLIB_drawString() would. The
+ * renderer does that only when the sample changes and copies the rows over
+ * the top left corner of every frame (render.h).
+ ******************************************************************************/
+
+#ifndef PERFHUD_H
+#define PERFHUD_H
+#include <stdint.h>
+#include "glib.h"
+
+#define PERF_HUD_TASKS   6
+#define PERF_HUD_COLUMNS 16 // characters per line
+#define PERF_HUD_WIDTH   (PERF_HUD_COLUMNS * 6) // pixels
+#define PERF_HUD_WORDS   (PERF_HUD_WIDTH / 32) // per row
+#define PERF_HUD_LINES   (4 + PERF_HUD_TASKS)
+#define PERF_HUD_HEIGHT  (PERF_HUD_LINES * 8) // pixels, at most
+
+struct perfHudTask {
+    const char *name; // up to 4 characters
+    uint16_t cpu; // 0.01 %
+    uint32_t stackFree; // stack words never used so far
+};
+
+struct perfHudSample {
+    uint16_t cpu; // 0.01 %, all tasks but the idle task
+    uint32_t rate; // display frames per second
+    uint32_t stepMicros; // physics step, mean since the last sample
+    uint32_t frameMicros; // latest display frame, composition to end of transfer
+    int tasks;
+    struct perfHudTask task[PERF_HUD_TASKS];
+};
+
+int perfHudHeight(const struct perfHudSample *sample);
+void perfHudDraw(uint32_t *rows, const struct perfHudSample *sample);
+
+#endif // PERFHUD_H
@@ -0,0 +1,131 @@
+/***************************************************************************//**
+ * @file
+ * @brief Game object and game state types shared by the physics and display
+ ******************************************************************************/
+
+#ifndef PHYSICS_H
+#define PHYSICS_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "fixedpoint.h"
+
+#ifndef PHYSICS_MAX_OBJECTS
+#define PHYSICS_MAX_OBJECTS 10 // pool capacity, override with -DPHYSICS_MAX_OBJECTS=n
+#endif
+#define JOULES_PER_KJ 1000 // energy and shot charge are tracked in J to stay integer
+
+enum objectType {empty, player, satchel, shot};
+// Positions and velocities are Q16.16 (see fixedpoint.h). Accelerations are
+// derived from force and mass inside the tick and are not stored.
+struct physicsData {
+    uint8_t objectType; // use objectType enum
+    uint16_t mass; // kg
+    fix16_t x;
+    fix16_t y;
+    fix16_t xVel;
+    fix16_t yVel;
+    int32_t xForce; // N
+    int32_t yForce; // N
+};
+
+// Where an object was before the latest physics step, for render interpolation
+struct objectPosition {
+    uint8_t objectType; // empty when the slot has no previous position
+    fix16_t x;
+    fix16_t y;
+};
+
+struct castleConstants {
+    int castleHeight; // cm
+    int foundationHitsRequired;
+    int foundationDepth; // cm
+};
+enum limitingMethod {AlwaysOne, MaxInFlight, PeriodicThrowTime};
+struct satchelConstants {
+    int limitingMethod;
+    int satchelDisplayDiameter; // Pixels
+    int throwPeriod; // in amount of physics periods
+    int maxInFlight; // amount of satchels allowed in flight
+    int maxInFlightPeriod; // in amount of physics periods
+    int satchelWeight;
+};
+struct platformConstants {
+    int maxPlatformForce; // Newtons
+    int platformMass; // KG
+    int platformLength; // cm
+    int maxPlatformBounceSpeed; // cm/s
+    int maxPlatformSpeed; // cm/s
+};
+struct shieldConstants {
+    int shieldEffectiveRange; // cm
+    int shieldActivationEnergy; // KJ
+};
+struct railGunConstants{
+    int railgunAngle; // degrees, initial aim. Use railgunSetAngle() to change it at runtime
+    int shotMass; // kg
+    int shotRadius; // pixels
+};
+struct generatorCosntants{
+    int energyCapacity; // KJ
+    int maxShotPower; // watts
+};
+struct physicsConstants {
+    int physicsPeriod; // ms
+    int sliderPeriod; // ms
+    int lcdPeriod; // ms
+    int canyonSize; // cm
+    struct castleConstants castleConst;
+    struct satchelConstants satchelConst;
+    struct platformConstants platformConst;
+    struct shieldConstants shieldConst;
+    struct railGunConstants railGunConst;
+    struct generatorCosntants generatorConst;
+};
+
+#define SCREEN_SIZE 127 // Actually 128 but 0 indexed. Profiles are scaled to it.
+#define GRAVITY     -10 // per s^2
+
+// Values the physics step needs, derived from a physicsConstants profile. The
+// profile table (profiles.c) holds them precomputed; other constants get them
+// from the same STEP_ macros once at gameInit().
+struct stepConstants {
+    fix16_t dt; // s
+    fix16_t gravityAcc;
+    int32_t chargePerTick; // J
+    int32_t maxShotCharge; // J
+    int32_t energyCapacity; // J
+    int32_t shieldEnergy; // J
+    int32_t platformForce; // N
+    int32_t halfPlatformForce; // N
+    int32_t platformInvMass; // FIX16_RECIP of kg
+    int32_t shotInvMass; // FIX16_RECIP of kg
+    fix16_t castleHeight;
+    fix16_t canyonSize;
+    fix16_t satchelRadius;
+    fix16_t halfPlatform;
+    fix16_t platformLength;
+    fix16_t maxPlatformSpeed;
+    fix16_t shieldRange;
+    fix16_t interceptRange;
+};
+
+#define STEP_DT(periodMs)                    FIX16_FROM_FRAC(periodMs, 1000)
+#define STEP_CHARGE_PER_TICK(power, periodMs) (((power) * (periodMs) * 2 + 1) / 3) // maxShotPower * period / 1.5, in J
+
+enum states {menu, active, win, fail};
+struct gameData {
+    int state; // use states enum
+    int32_t energy; // J
+    int32_t shotCharge; // J
+    int foundationDamage;
+    bool evacComplete;
+    bool shieldActive; // true only for the tick in which a shield fired
+    int satchelsThrown;
+    int satchelsIntercepted; // destroyed mid-air by a shot
+    int shieldsActivated;
+    int usefulShields;
+    int shotsFired;
+    int profile; // physicsProfiles index, GAME_CUSTOM_PROFILE for other constants
+};
+
+#endif // PHYSICS_H
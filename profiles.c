@@ -0,0 +1,187 @@
+/***************************************************************************//**
+ * @file
+ * @brief Physics profiles, scaled and derived at compile time
+ ******************************************************************************/
+
+#include <string.h>
+#include "profiles.h"
+
+/***************************************************************************//**
+ * Authored values. Lengths, forces and speeds are divided by
+ * CANYON_SIZE / SCREEN_SIZE when the table is built, as the old
+ * physicsConstantsInit() did at boot.
+ ******************************************************************************/
+// Normal Version
+#define NORMAL_PHYSICS_PERIOD            50
+#define NORMAL_SLIDER_PERIOD             100
+#define NORMAL_LCD_PERIOD                150
+#define NORMAL_CANYON_SIZE               SCREEN_SIZE
+#define NORMAL_CASTLE_HEIGHT             (SCREEN_SIZE * 3 / 4)
+#define NORMAL_FOUNDATION_HITS           3
+#define NORMAL_FOUNDATION_DEPTH          21
+#define NORMAL_LIMITING_METHOD           AlwaysOne
+#define NORMAL_SATCHEL_DIAMETER          7
+#define NORMAL_THROW_PERIOD              5
+#define NORMAL_MAX_IN_FLIGHT             2
+#define NORMAL_MAX_IN_FLIGHT_PERIOD      10
+#define NORMAL_SATCHEL_WEIGHT            1000
+#define NORMAL_PLATFORM_FORCE            5000
+#define NORMAL_PLATFORM_MASS             100
+#define NORMAL_PLATFORM_LENGTH           16
+#define NORMAL_PLATFORM_BOUNCE_SPEED     5000
+#define NORMAL_PLATFORM_SPEED            5000
+#define NORMAL_SHIELD_RANGE              20
+#define NORMAL_SHIELD_ENERGY             30
+#define NORMAL_RAILGUN_ANGLE             (int)(3*3.1415/4 * 100)
+#define NORMAL_SHOT_MASS                 50
+#define NORMAL_SHOT_RADIUS               5
+#define NORMAL_ENERGY_CAPACITY           50
+#define NORMAL_SHOT_POWER                20
+
+// Suggested Version
+#define SUGGESTED_PHYSICS_PERIOD         50
+#define SUGGESTED_SLIDER_PERIOD          100
+#define SUGGESTED_LCD_PERIOD             150
+#define SUGGESTED_CANYON_SIZE            100000
+#define SUGGESTED_CASTLE_HEIGHT          5000
+#define SUGGESTED_FOUNDATION_HITS        2
+#define SUGGESTED_FOUNDATION_DEPTH       5000
+#define SUGGESTED_LIMITING_METHOD        AlwaysOne
+#define SUGGESTED_SATCHEL_DIAMETER       10
+#define SUGGESTED_THROW_PERIOD           1000
+#define SUGGESTED_MAX_IN_FLIGHT          2
+#define SUGGESTED_MAX_IN_FLIGHT_PERIOD   500
+#define SUGGESTED_SATCHEL_WEIGHT         1000
+#define SUGGESTED_PLATFORM_FORCE         20000000
+#define SUGGESTED_PLATFORM_MASS          100
+#define SUGGESTED_PLATFORM_LENGTH        10000
+#define SUGGESTED_PLATFORM_BOUNCE_SPEED  50000
+#define SUGGESTED_PLATFORM_SPEED         50000
+#define SUGGESTED_SHIELD_RANGE           15000
+#define SUGGESTED_SHIELD_ENERGY          30000
+#define SUGGESTED_RAILGUN_ANGLE          800
+#define SUGGESTED_SHOT_MASS              50
+#define SUGGESTED_SHOT_RADIUS            5
+#define SUGGESTED_ENERGY_CAPACITY        50000
+#define SUGGESTED_SHOT_POWER             20000
+
+// Normal Version with slower throws and a shallower foundation
+#define SLOWTHROW_PHYSICS_PERIOD         50
+#define SLOWTHROW_SLIDER_PERIOD          100
+#define SLOWTHROW_LCD_PERIOD             150
+#define SLOWTHROW_CANYON_SIZE            SCREEN_SIZE
+#define SLOWTHROW_CASTLE_HEIGHT          (SCREEN_SIZE * 3 / 4)
+#define SLOWTHROW_FOUNDATION_HITS        3
+#define SLOWTHROW_FOUNDATION_DEPTH       20
+#define SLOWTHROW_LIMITING_METHOD        AlwaysOne
+#define SLOWTHROW_SATCHEL_DIAMETER       7
+#define SLOWTHROW_THROW_PERIOD           10
+#define SLOWTHROW_MAX_IN_FLIGHT          2
+#define SLOWTHROW_MAX_IN_FLIGHT_PERIOD   10
+#define SLOWTHROW_SATCHEL_WEIGHT         1000
+#define SLOWTHROW_PLATFORM_FORCE         5000
+#define SLOWTHROW_PLATFORM_MASS          100
+#define SLOWTHROW_PLATFORM_LENGTH        16
+#define SLOWTHROW_PLATFORM_BOUNCE_SPEED  5000
+#define SLOWTHROW_PLATFORM_SPEED         5000
+#define SLOWTHROW_SHIELD_RANGE           20
+#define SLOWTHROW_SHIELD_ENERGY          30
+#define SLOWTHROW_RAILGUN_ANGLE          (int)(3*3.1415/4 * 100)
+#define SLOWTHROW_SHOT_MASS              50
+#define SLOWTHROW_SHOT_RADIUS            5
+#define SLOWTHROW_ENERGY_CAPACITY        50
+#define SLOWTHROW_SHOT_POWER             20
+
+/***************************************************************************//**
+ * Table construction
+ ******************************************************************************/
+#define RATIO(P)         (P##_CANYON_SIZE / SCREEN_SIZE)
+#define SCALED(P, FIELD) (P##_##FIELD / RATIO(P))
+
+#define PROFILE(P, NAME) {                                                          \
+    .name = NAME,                                                                  \
+    .unitsPerPixel = RATIO(P),                                                     \
+    .consts = {                                                                    \
+        .physicsPeriod = P##_PHYSICS_PERIOD,                                       \
+        .sliderPeriod = P##_SLIDER_PERIOD,                                         \
+        .lcdPeriod = P##_LCD_PERIOD,                                               \
+        .canyonSize = SCREEN_SIZE,                                                 \
+        .castleConst = {                                                           \
+            .castleHeight = SCALED(P, CASTLE_HEIGHT),                              \
+            .foundationHitsRequired = P##_FOUNDATION_HITS,                         \
+            .foundationDepth = SCALED(P, FOUNDATION_DEPTH)                         \
+        },                                                                         \
+        .satchelConst = {                                                          \
+            .limitingMethod = P##_LIMITING_METHOD,                                 \
+            .satchelDisplayDiameter = SCALED(P, SATCHEL_DIAMETER),                 \
+            .throwPeriod = P##_THROW_PERIOD,                                       \
+            .maxInFlight = P##_MAX_IN_FLIGHT,                                      \
+            .maxInFlightPeriod = P##_MAX_IN_FLIGHT_PERIOD,                         \
+            .satchelWeight = P##_SATCHEL_WEIGHT                                    \
+        },                                                                         \
+        .platformConst = {                                                         \
+            .maxPlatformForce = SCALED(P, PLATFORM_FORCE),                         \
+            .platformMass = P##_PLATFORM_MASS,                                     \
+            .platformLength = SCALED(P, PLATFORM_LENGTH),                          \
+            .maxPlatformBounceSpeed = SCALED(P, PLATFORM_BOUNCE_SPEED),            \
+            .maxPlatformSpeed = SCALED(P, PLATFORM_SPEED)                          \
+        },                                                                         \
+        .shieldConst = {                                                           \
+            .shieldEffectiveRange = SCALED(P, SHIELD_RANGE),                       \
+            .shieldActivationEnergy = P##_SHIELD_ENERGY                            \
+        },                                                                         \
+        .railGunConst = {                                                          \
+            .railgunAngle = P##_RAILGUN_ANGLE,                                     \
+            .shotMass = P##_SHOT_MASS,                                             \
+            .shotRadius = SCALED(P, SHOT_RADIUS)                                   \
+        },                                                                         \
+        .generatorConst = {                                                        \
+            .energyCapacity = P##_ENERGY_CAPACITY,                                 \
+            .maxShotPower = P##_SHOT_POWER                                         \
+        }                                                                          \
+    },                                                                             \
+    .step = {                                                                      \
+        .dt = STEP_DT(P##_PHYSICS_PERIOD),                                         \
+        .gravityAcc = FIX16_FROM_INT(GRAVITY),                                     \
+        .chargePerTick = STEP_CHARGE_PER_TICK(P##_SHOT_POWER, P##_PHYSICS_PERIOD), \
+        .maxShotCharge = P##_SHOT_POWER * JOULES_PER_KJ,                           \
+        .energyCapacity = P##_ENERGY_CAPACITY * JOULES_PER_KJ,                     \
+        .shieldEnergy = P##_SHIELD_ENERGY * JOULES_PER_KJ,                         \
+        .platformForce = SCALED(P, PLATFORM_FORCE),                                \
+        .halfPlatformForce = SCALED(P, PLATFORM_FORCE) / 2,                        \
+        .platformInvMass = FIX16_RECIP(P##_PLATFORM_MASS),                         \
+        .shotInvMass = FIX16_RECIP(P##_SHOT_MASS),                                 \
+        .castleHeight = FIX16_FROM_INT(SCALED(P, CASTLE_HEIGHT)),                  \
+        .canyonSize = FIX16_FROM_INT(SCREEN_SIZE),                                 \
+        .satchelRadius = FIX16_FROM_INT(SCALED(P, SATCHEL_DIAMETER) / 2),          \
+        .halfPlatform = FIX16_FROM_INT(SCALED(P, PLATFORM_LENGTH) / 2),            \
+        .platformLength = FIX16_FROM_INT(SCALED(P, PLATFORM_LENGTH)),              \
+        .maxPlatformSpeed = FIX16_FROM_INT(SCALED(P, PLATFORM_SPEED)),             \
+        .shieldRange = FIX16_FROM_INT(SCALED(P, SHIELD_RANGE)),                    \
+        .interceptRange = FIX16_FROM_INT(SCALED(P, SHOT_RADIUS)                    \
+                                         + SCALED(P, SATCHEL_DIAMETER) / 2)        \
+    }                                                                              \
+}
+
+const struct physicsProfile physicsProfiles[PHYSICS_PROFILE_COUNT] = {
+    [profileNormal] = PROFILE(NORMAL, "Normal"),
+    [profileSuggested] = PROFILE(SUGGESTED, "Suggested"),
+    [profileNormalSlowThrow] = PROFILE(SLOWTHROW, "Slow throw"),
+};
+
+/***************************************************************************//**
+ * @brief
+ *   Looks a profile up by its name or its index, -1 if there is none.
+ ******************************************************************************/
+int physicsProfileFromName(const char *name)
+{
+    for (int i = 0; i < PHYSICS_PROFILE_COUNT; i++) {
+        if (strcmp(name, physicsProfiles[i].name) == 0) {
+            return i;
+        }
+    }
+    if (name[0] >= '0' && name[0] < '0' + PHYSICS_PROFILE_COUNT && name[1] == '\0') {
+        return name[0] - '0';
+    }
+    return -1;
+}
@@ -0,0 +1,32 @@
+/***************************************************************************//**
+ * @file
+ * @brief Physics profiles, scaled and derived at compile time
+ *******************************************************************************
+ * Each profile is authored in its own units and scaled to SCREEN_SIZE by the
+ * preprocessor, so the table, including the step constants the physics tick
+ * uses, is const data in flash. Nothing is divided at boot or per tick. The
+ * menu picks a profile at runtime.
+ ******************************************************************************/
+
+#ifndef PROFILES_H
+#define PROFILES_H
+#include "physics.h"
+
+#define PHYSICS_VERSION 1 // Profile highlighted when the menu opens, 1 based
+
+enum physicsProfileId {profileNormal, profileSuggested, profileNormalSlowThrow, PHYSICS_PROFILE_COUNT};
+
+struct physicsProfile {
+    const char *name;
+    int unitsPerPixel; // authored units per screen pixel, the old scaling ratio
+    struct physicsConstants consts; // scaled to the screen
+    struct stepConstants step;
+};
+
+extern const struct physicsProfile physicsProfiles[PHYSICS_PROFILE_COUNT];
+
+int physicsProfileFromName(const char *name);
+
+#define PHYSICS_DEFAULT_PROFILE (PHYSICS_VERSION - 1)
+
+#endif // PROFILES_H
@@ -0,0 +1,326 @@
+/***************************************************************************//**
+ * @file
+ * @brief Input recorder and replay for deterministic playback
+ ******************************************************************************/
+
+#include <string.h>
+#include "recorder.h"
+
+#define RING_MASK (RECORDER_RING_BYTES - 1u)
+#define CONSTANT_COUNT (sizeof(struct physicsConstants) / sizeof(int)) // every field is an int
+#define HEADER_STEPS 4 // offset of the patched step count
+
+#if (RECORDER_RING_BYTES & RING_MASK) != 0
+#error "RECORDER_RING_BYTES must be a power of two"
+#endif
+
+static uint32_t zigzag(int32_t value)
+{
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value)
+{
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+/***************************************************************************//**
+ * Ring writes
+ ******************************************************************************/
+// Appends a byte to the current record, dropping the oldest records to make room.
+// A game that fills the ring by itself is abandoned.
+static void ringPut(struct recorder *rec, uint8_t byte)
+{
+    if (!rec->recording) {
+        return;
+    }
+    while (rec->head - rec->tail >= RECORDER_RING_BYTES) {
+        if (rec->tail == rec->current) {
+            rec->head = rec->current;
+            rec->recording = false;
+            rec->overflows++;
+            return;
+        }
+        uint32_t length = 0;
+        for (int i = 3; i >= 0; i--) {
+            length = (length << 8) | rec->ring[(rec->tail + i) & RING_MASK];
+        }
+        rec->tail += length;
+        rec->records--;
+        rec->evicted++;
+    }
+    rec->ring[rec->head++ & RING_MASK] = byte;
+}
+
+static void ringPut32(struct recorder *rec, uint32_t value)
+{
+    for (int i = 0; i < 4; i++) {
+        ringPut(rec, (uint8_t)(value >> (8 * i)));
+    }
+}
+
+static void ringPatch32(struct recorder *rec, uint32_t at, uint32_t value)
+{
+    for (int i = 0; i < 4; i++) {
+        rec->ring[(at + i) & RING_MASK] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static void ringPutVarint(struct recorder *rec, uint32_t value)
+{
+    while (value >= 0x80) {
+        ringPut(rec, (uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    ringPut(rec, (uint8_t)value);
+}
+
+/***************************************************************************//**
+ * Recording
+ ******************************************************************************/
+void recorderInit(struct recorder *rec)
+{
+    memset(rec, 0, sizeof(*rec));
+    rec->lastInputs = RECORDER_NO_INPUTS;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Starts a record for a game about to be run with gameInit(seed, consts).
+ *   An unfinished record from an earlier game is discarded.
+ ******************************************************************************/
+void recorderBegin(struct recorder *rec, uint32_t seed, const struct physicsConstants *consts)
+{
+    if (rec->recording) {
+        rec->head = rec->current;
+    }
+    rec->current = rec->head;
+    rec->recording = true;
+    rec->steps = 0;
+    rec->repeats = 0;
+    rec->lastInputs = RECORDER_NO_INPUTS;
+    ringPut32(rec, 0); // length, patched by recorderFinish()
+    ringPut32(rec, 0); // steps, patched by recorderFinish()
+    ringPut(rec, RECORDER_VERSION);
+    ringPutVarint(rec, seed);
+    ringPutVarint(rec, CONSTANT_COUNT);
+    const int *values = (const int *)consts;
+    for (unsigned i = 0; i < CONSTANT_COUNT; i++) {
+        ringPutVarint(rec, zigzag(values[i]));
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Slow path of recorderTick(): closes the previous run and encodes the new
+ *   inputs.
+ ******************************************************************************/
+void recorderChange(struct recorder *rec, uint32_t packed)
+{
+    uint32_t previous = rec->lastInputs;
+    rec->lastInputs = packed;
+    if (!rec->recording) {
+        return;
+    }
+    if (previous != RECORDER_NO_INPUTS) {
+        ringPutVarint(rec, rec->repeats);
+    }
+    rec->repeats = 0;
+    uint16_t aim = (uint16_t)(packed >> 16);
+    uint16_t lastAim = previous == RECORDER_NO_INPUTS ? 0 : (uint16_t)(previous >> 16);
+    uint8_t byte = (uint8_t)(packed & 0x7F);
+    if (aim != lastAim) {
+        byte |= RECORDER_AIM;
+    }
+    ringPut(rec, byte);
+    if (aim != lastAim) {
+        ringPutVarint(rec, zigzag((int16_t)(aim - lastAim))); // Shortest way around the circle
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Closes the current record with the outcome the replay must reproduce.
+ ******************************************************************************/
+void recorderFinish(struct recorder *rec, const struct gameData *outcome)
+{
+    if (!rec->recording) {
+        return;
+    }
+    if (rec->steps > 0) {
+        ringPutVarint(rec, rec->repeats);
+    }
+    const int32_t fields[] = {
+        outcome->state, outcome->energy, outcome->shotCharge, outcome->foundationDamage,
+        outcome->evacComplete, outcome->satchelsThrown, outcome->satchelsIntercepted,
+        outcome->shieldsActivated, outcome->usefulShields, outcome->shotsFired
+    };
+    for (unsigned i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        ringPutVarint(rec, zigzag(fields[i]));
+    }
+    if (rec->recording) {
+        ringPatch32(rec, rec->current, rec->head - rec->current);
+        ringPatch32(rec, rec->current + HEADER_STEPS, rec->steps);
+        rec->records++;
+        rec->recording = false;
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Copies a complete record out of the ring, 0 being the most recent.
+ *   Returns its length, or 0 if there is no such record or it does not fit.
+ ******************************************************************************/
+uint32_t recorderExport(const struct recorder *rec, unsigned newest, uint8_t *out, uint32_t size)
+{
+    if (newest >= rec->records) {
+        return 0;
+    }
+    uint32_t at = rec->tail;
+    uint32_t length = 0;
+    for (unsigned skip = rec->records - newest; skip > 0; skip--) {
+        at += length;
+        length = 0;
+        for (int i = 3; i >= 0; i--) {
+            length = (length << 8) | rec->ring[(at + i) & RING_MASK];
+        }
+    }
+    if (length > size) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < length; i++) {
+        out[i] = rec->ring[(at + i) & RING_MASK];
+    }
+    return length;
+}
+
+/***************************************************************************//**
+ * Replay
+ ******************************************************************************/
+static bool readVarint(struct replay *rp, uint32_t *value)
+{
+    uint32_t result = 0;
+    for (int shift = 0; shift < 35 && rp->pos < rp->length; shift += 7) {
+        uint8_t byte = rp->data[rp->pos++];
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t read32(const uint8_t *data)
+{
+    return data[0] | (uint32_t)data[1] << 8 | (uint32_t)data[2] << 16 | (uint32_t)data[3] << 24;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Opens an exported record and returns the seed and constants to pass to
+ *   gameInit(). False if the record is malformed or from another version.
+ ******************************************************************************/
+bool replayOpen(struct replay *rp, const uint8_t *data, uint32_t length, uint32_t *seed, struct physicsConstants *consts)
+{
+    memset(rp, 0, sizeof(*rp));
+    if (length < 9 || read32(data) > length || data[8] != RECORDER_VERSION) {
+        return false;
+    }
+    rp->data = data;
+    rp->length = read32(data);
+    rp->stepsLeft = read32(data + HEADER_STEPS);
+    rp->pos = 9;
+    uint32_t count, value;
+    if (!readVarint(rp, seed) || !readVarint(rp, &count) || count != CONSTANT_COUNT) {
+        return false;
+    }
+    int *values = (int *)consts;
+    for (unsigned i = 0; i < CONSTANT_COUNT; i++) {
+        if (!readVarint(rp, &value)) {
+            return false;
+        }
+        values[i] = unzigzag(value);
+    }
+    return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Inputs for the next step. False once every recorded step has been played.
+ ******************************************************************************/
+bool replayNext(struct replay *rp, struct gameInputs *inputs)
+{
+    if (rp->stepsLeft == 0) {
+        return false;
+    }
+    if (rp->repeatsLeft > 0) {
+        rp->repeatsLeft--;
+    } else {
+        uint32_t delta;
+        if (rp->pos >= rp->length) {
+            rp->stepsLeft = 0;
+            return false;
+        }
+        uint8_t byte = rp->data[rp->pos++];
+        rp->inputs.farLeft = byte & RECORDER_FAR_LEFT;
+        rp->inputs.left = byte & RECORDER_LEFT;
+        rp->inputs.right = byte & RECORDER_RIGHT;
+        rp->inputs.farRight = byte & RECORDER_FAR_RIGHT;
+        rp->inputs.charge = byte & RECORDER_CHARGE;
+        rp->inputs.shield = byte & RECORDER_SHIELD;
+        rp->inputs.evacComplete = byte & RECORDER_EVAC;
+        if (byte & RECORDER_AIM) {
+            if (!readVarint(rp, &delta)) {
+                rp->stepsLeft = 0;
+                return false;
+            }
+            rp->inputs.aim += (angle_t)unzigzag(delta);
+        }
+        if (!readVarint(rp, &rp->repeatsLeft)) {
+            rp->stepsLeft = 0;
+            return false;
+        }
+    }
+    rp->stepsLeft--;
+    *inputs = rp->inputs;
+    return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   The outcome stored with the record. Skips any steps not yet played.
+ ******************************************************************************/
+bool replayOutcome(struct replay *rp, struct gameData *outcome)
+{
+    struct gameInputs skipped;
+    while (replayNext(rp, &skipped)) {}
+    uint32_t fields[10];
+    for (unsigned i = 0; i < 10; i++) {
+        if (!readVarint(rp, &fields[i])) {
+            return false;
+        }
+    }
+    memset(outcome, 0, sizeof(*outcome));
+    outcome->state = unzigzag(fields[0]);
+    outcome->energy = unzigzag(fields[1]);
+    outcome->shotCharge = unzigzag(fields[2]);
+    outcome->foundationDamage = unzigzag(fields[3]);
+    outcome->evacComplete = unzigzag(fields[4]);
+    outcome->satchelsThrown = unzigzag(fields[5]);
+    outcome->satchelsIntercepted = unzigzag(fields[6]);
+    outcome->shieldsActivated = unzigzag(fields[7]);
+    outcome->usefulShields = unzigzag(fields[8]);
+    outcome->shotsFired = unzigzag(fields[9]);
+    return true;
+}
+
+// Compares the fields a record stores
+bool replaySameOutcome(const struct gameData *a, const struct gameData *b)
+{
+    return a->state == b->state && a->energy == b->energy && a->shotCharge == b->shotCharge
+        && a->foundationDamage == b->foundationDamage && a->evacComplete == b->evacComplete
+        && a->satchelsThrown == b->satchelsThrown && a->satchelsIntercepted == b->satchelsIntercepted
+        && a->shieldsActivated == b->shieldsActivated && a->usefulShields == b->usefulShields
+        && a->shotsFired == b->shotsFired;
+}
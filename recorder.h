@@ -0,0 +1,115 @@
+/***************************************************************************//**
+ * @file
+ * @brief Input recorder and replay for deterministic playback
+ *******************************************************************************
+ * Each game is recorded as the seed, the physicsConstants profile and the
+ * per-step gameInputs, which is everything physicsStep() depends on. Inputs
+ * are stored as changes: the packed input byte (plus the aim delta when the
+ * aim moved) followed by a varint count of the steps that repeated it, so a
+ * quiet step costs nothing but a counter increment. Records sit back to back
+ * in a RAM ring; when it fills, the oldest whole record is dropped.
+ *
+ * Record layout (integers are little endian, varints are LEB128, signed
+ * values are zigzag encoded):
+ *   u32 length, u32 steps, u8 version, varint seed,
+ *   varint constant count, zigzag constants...,
+ *   events: u8 inputs [zigzag aim delta] varint repeats, ...
+ *   outcome: zigzag gameData fields (see recorder.c)
+ ******************************************************************************/
+
+#ifndef RECORDER_H
+#define RECORDER_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "game.h"
+
+#ifndef RECORDER_RING_BYTES
+#define RECORDER_RING_BYTES 4096 // must be a power of two
+#endif
+#define RECORDER_VERSION    1
+
+// Bits of the packed input byte
+#define RECORDER_FAR_LEFT   0x01u
+#define RECORDER_LEFT       0x02u
+#define RECORDER_RIGHT      0x04u
+#define RECORDER_FAR_RIGHT  0x08u
+#define RECORDER_CHARGE     0x10u
+#define RECORDER_SHIELD     0x20u
+#define RECORDER_EVAC       0x40u
+#define RECORDER_AIM        0x80u // an aim delta follows
+#define RECORDER_NO_INPUTS  0xFFFFFFFFu
+
+struct recorder {
+    uint8_t ring[RECORDER_RING_BYTES];
+    uint32_t head; // next write, free running
+    uint32_t tail; // oldest record, free running
+    uint32_t current; // start of the record being written
+    bool recording;
+    uint32_t steps; // in the current record
+    uint32_t lastInputs; // packed inputs and aim of the previous step
+    uint32_t repeats; // steps since lastInputs last changed
+    uint16_t records; // complete records in the ring
+    uint16_t evicted; // records dropped to make room
+    uint16_t overflows; // games too long to fit the ring on their own
+};
+
+struct replay {
+    const uint8_t *data;
+    uint32_t length;
+    uint32_t pos;
+    uint32_t stepsLeft;
+    uint32_t repeatsLeft;
+    struct gameInputs inputs;
+};
+
+static inline uint32_t recorderPack(const struct gameInputs *inputs)
+{
+    return (inputs->farLeft ? RECORDER_FAR_LEFT : 0) | (inputs->left ? RECORDER_LEFT : 0)
+         | (inputs->right ? RECORDER_RIGHT : 0) | (inputs->farRight ? RECORDER_FAR_RIGHT : 0)
+         | (inputs->charge ? RECORDER_CHARGE : 0) | (inputs->shield ? RECORDER_SHIELD : 0)
+         | (inputs->evacComplete ? RECORDER_EVAC : 0) | ((uint32_t)inputs->aim << 16);
+}
+
+void recorderInit(struct recorder *rec);
+void recorderBegin(struct recorder *rec, uint32_t seed, const struct physicsConstants *consts);
+void recorderChange(struct recorder *rec, uint32_t packed);
+void recorderFinish(struct recorder *rec, const struct gameData *outcome);
+uint32_t recorderExport(const struct recorder *rec, unsigned newest, uint8_t *out, uint32_t size);
+
+/***************************************************************************//**
+ * @brief
+ *   Records the inputs of one step. An unchanged step is a compare and an
+ *   increment; only changes are encoded.
+ ******************************************************************************/
+static inline void recorderTick(struct recorder *rec, const struct gameInputs *inputs)
+{
+    uint32_t packed = recorderPack(inputs);
+    rec->steps++;
+    if (packed == rec->lastInputs) {
+        rec->repeats++;
+    } else {
+        recorderChange(rec, packed);
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Records count steps that all had the same inputs, e.g. steps the physics
+ *   task fast-forwarded while idle.
+ ******************************************************************************/
+static inline void recorderRepeat(struct recorder *rec, const struct gameInputs *inputs, uint32_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    recorderTick(rec, inputs);
+    rec->steps += count - 1;
+    rec->repeats += count - 1;
+}
+
+bool replayOpen(struct replay *rp, const uint8_t *data, uint32_t length, uint32_t *seed, struct physicsConstants *consts);
+bool replayNext(struct replay *rp, struct gameInputs *inputs);
+bool replayOutcome(struct replay *rp, struct gameData *outcome);
+bool replaySameOutcome(const struct gameData *a, const struct gameData *b);
+
+#endif // RECORDER_H
@@ -0,0 +1,370 @@
+/***************************************************************************//**
+ * @file
+ * @brief Draws the game's screens into the display framebuffer
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "profiles.h"
+#include "render.h"
+
+static const int screenSize = SCREEN_SIZE;
+
+void renderInit(struct renderer *r, GLIB_Context_t *glib, void *framebuffer, bool staticLayer)
+{
+    memset(r, 0, sizeof(*r));
+    r->glib = glib;
+    r->framebuffer = framebuffer;
+    r->staticLayer = staticLayer;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Clears the framebuffer and draws what only changes with the profile or
+ *   the foundation damage: the cliff, the right wall, the castle and the
+ *   battery outline.
+ ******************************************************************************/
+static void drawBackground(struct renderer *r, const struct physicsConstants *consts, int foundationDamage)
+{
+    struct __GLIB_Rectangle_t rectangles[7];
+    struct __GLIB_Rectangle_t battery[5];
+    GLIB_clear(r->glib);
+    // Generate cliff
+    GLIB_drawLineV(r->glib, 0, screenSize - consts->castleConst.castleHeight - consts->castleConst.foundationDepth, screenSize);
+    GLIB_drawLineV(r->glib, 1, screenSize - consts->castleConst.castleHeight - consts->castleConst.foundationDepth, screenSize);
+    // Generate right wall
+    GLIB_drawLineV(r->glib, screenSize, 0, screenSize);
+    GLIB_drawLineV(r->glib, screenSize - 1, 0, screenSize - 1);
+    // Generate castle
+    // Left wall
+    rectangles[0].xMin = 0;
+    rectangles[0].xMax = consts->castleConst.foundationHitsRequired * 2;
+    rectangles[0].yMin = 0;
+    rectangles[0].yMax = screenSize - consts->castleConst.castleHeight;
+    // Ceiling
+    rectangles[1].xMin = 0;
+    rectangles[1].xMax = 20;
+    rectangles[1].yMin = 0;
+    rectangles[1].yMax = 5;
+    // Right wall
+    rectangles[2].xMin = 15;
+    rectangles[2].xMax = 20;
+    rectangles[2].yMin = 0;
+    rectangles[2].yMax = screenSize - consts->castleConst.castleHeight;
+    // Floor
+    rectangles[3].xMin = 0;
+    rectangles[3].xMax = 20;
+    rectangles[3].yMin = screenSize - consts->castleConst.castleHeight - 5;
+    rectangles[3].yMax = screenSize - consts->castleConst.castleHeight;
+    // Flag pole
+    rectangles[4].xMin = 20;
+    rectangles[4].xMax = 35;
+    rectangles[4].yMin = 0;
+    rectangles[4].yMax = 2;
+    // Flag
+    rectangles[5].xMin = 25;
+    rectangles[5].xMax = 35;
+    rectangles[5].yMin = 0;
+    rectangles[5].yMax = screenSize - consts->castleConst.castleHeight - 10;
+    // Generate Foundation
+    rectangles[6].xMin = 0;
+    rectangles[6].xMax = (consts->castleConst.foundationHitsRequired - foundationDamage) * 2;
+    rectangles[6].yMin = screenSize - consts->castleConst.castleHeight;
+    rectangles[6].yMax = screenSize - consts->castleConst.castleHeight + consts->castleConst.foundationDepth;
+    // Draw castle
+    for (int i = 0; i < 7; i++) {
+        GLIB_drawRectFilled(r->glib, &rectangles[i]);
+    }
+    // Left Battery wall
+    battery[0].xMin = screenSize - 16;
+    battery[0].xMax = screenSize - 15;
+    battery[0].yMin = 10;
+    battery[0].yMax = 35;
+    // Top Battery
+    battery[1].xMin = screenSize - 16;
+    battery[1].xMax = screenSize - 5;
+    battery[1].yMin = 10;
+    battery[1].yMax = 11;
+    // Right Battery wall
+    battery[2].xMin = screenSize - 6;
+    battery[2].xMax = screenSize - 5;
+    battery[2].yMin = 10;
+    battery[2].yMax = 35;
+    // Bottom Battery
+    battery[3].xMin = screenSize - 16;
+    battery[3].xMax = screenSize - 5;
+    battery[3].yMin = 34;
+    battery[3].yMax = 35;
+    // Battery bump
+    battery[4].xMin = screenSize - 13;
+    battery[4].xMax = screenSize - 8;
+    battery[4].yMin = 5;
+    battery[4].yMax = 10;
+    for (int i = 0; i < 5; i++) {
+        GLIB_drawRectFilled(r->glib, &battery[i]);
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Rasterizes the barrel for the scene's aim and profile: four lines, side
+ *   by side, from the platform to platformLength along the aim.
+ ******************************************************************************/
+static void buildCannon(struct renderer *r, const struct renderScene *scene)
+{
+    int cannonLength = scene->consts->platformConst.platformLength;
+    r->cannonDx = fix16ToInt(fix16MulInt(angleCos(scene->aim), cannonLength));
+    r->cannonDy = fix16ToInt(fix16MulInt(angleSin(scene->aim), cannonLength));
+    int left = (r->cannonDx < 0 ? r->cannonDx : 0) - 1;
+    int top = r->cannonDy < 0 ? r->cannonDy : 0;
+    int width = (r->cannonDx < 0 ? -r->cannonDx : r->cannonDx) + 4;
+    int height = (r->cannonDy < 0 ? -r->cannonDy : r->cannonDy) + 1;
+    if (spriteEmpty(&r->cannon, width, height, -left, -top)) {
+        for (int i = -1; i < 3; i++) {
+            spriteLine(&r->cannon, r->cannonDx + i, r->cannonDy, i, 0);
+        }
+    }
+    r->cannonVersion = scene->aimVersion;
+}
+
+// Rasterizes the sprites for the scene's profile
+static void buildSprites(struct renderer *r, const struct renderScene *scene)
+{
+    const struct physicsConstants *consts = scene->consts;
+    int halfLength = consts->platformConst.platformLength / 2;
+    spriteCircle(&r->satchel, consts->satchelConst.satchelDisplayDiameter / 2);
+    spriteCircle(&r->shot, consts->railGunConst.shotRadius);
+    spriteRect(&r->platform, 2 * halfLength + 1, 5, halfLength, 0);
+    buildCannon(r, scene); // Its length is the platform's
+    r->spriteConsts = consts;
+}
+
+// Top row of the remaining-battery bar
+static int batteryTop(const struct physicsConstants *consts, const struct gameData *game)
+{
+    return 31 - (game->energy * 20 / (consts->generatorConst.energyCapacity * JOULES_PER_KJ));
+}
+
+static uint32_t hashWord(uint32_t hash, uint32_t word)
+{
+    return (hash ^ word) * 16777619u; // FNV-1a, a word at a time
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Hash of everything the scene's screen is drawn from, at the resolution it
+ *   is drawn at: scenes with the same hash put the same pixels on the panel.
+ ******************************************************************************/
+uint32_t renderHash(const struct renderer *r, const struct renderScene *scene)
+{
+    const struct gameFrame *frame = scene->frame;
+    uint32_t hash = hashWord(2166136261u, (uint32_t)frame->game.state);
+    hash = hashWord(hash, (uint32_t)frame->game.profile);
+    hash = hashWord(hash, scene->hud ? scene->hudVersion : 0);
+    if (frame->game.state == win) {
+        hash = hashWord(hash, frame->game.evacComplete);
+    }
+    if (frame->game.state != active) {
+        return hash;
+    }
+    hash = hashWord(hash, (uint32_t)(uintptr_t)scene->consts);
+    hash = hashWord(hash, (uint32_t)frame->game.foundationDamage);
+    hash = hashWord(hash, (uint32_t)batteryTop(scene->consts, &frame->game));
+    hash = hashWord(hash, scene->aimVersion);
+    hash = hashWord(hash, frame->game.shieldsActivated != r->shieldsDrawn);
+    hash = hashWord(hash, (uint32_t)fix16ToInt(frame->objects[0].x));
+    for (int i = 0; i < PHYSICS_MAX_OBJECTS; i++) {
+        if (frame->objects[i].objectType == satchel || frame->objects[i].objectType == shot) {
+            hash = hashWord(hash, (uint32_t)frame->objects[i].objectType);
+            hash = hashWord(hash, (uint32_t)fix16ToInt(frame->objects[i].x));
+            hash = hashWord(hash, (uint32_t)fix16ToInt(frame->objects[i].y));
+        }
+    }
+    return hash;
+}
+
+static void drawMenu(struct renderer *r, const struct gameFrame *frame)
+{
+    GLIB_clear(r->glib);
+    GLIB_drawStringOnLine(r->glib,
+                            "Physics profile",
+                            0,
+                            GLIB_ALIGN_LEFT,
+                            5,
+                            5,
+                            true);
+    for (int i = 0; i < PHYSICS_PROFILE_COUNT; i++) {
+        char line[24];
+        snprintf(line, sizeof(line), "%c %s", i == frame->game.profile ? '>' : ' ', physicsProfiles[i].name);
+        GLIB_drawStringOnLine(r->glib, line, 2 + i, GLIB_ALIGN_LEFT, 5, 15, true);
+    }
+    GLIB_drawStringOnLine(r->glib, "BTN1 next", 7, GLIB_ALIGN_LEFT, 5, 25, true);
+    GLIB_drawStringOnLine(r->glib, "BTN0 start", 8, GLIB_ALIGN_LEFT, 5, 25, true);
+}
+
+static void drawGame(struct renderer *r, const struct renderScene *scene)
+{
+    const struct gameFrame *frame = scene->frame;
+    const struct physicsData *objects = frame->objects;
+    const struct physicsConstants *consts = scene->consts;
+    struct __GLIB_Rectangle_t battery;
+    struct __GLIB_Rectangle_t platform;
+    if (!r->staticLayer) {
+        drawBackground(r, consts, frame->game.foundationDamage);
+    } else if (r->backgroundConsts != consts || r->backgroundDamage != frame->game.foundationDamage) {
+        drawBackground(r, consts, frame->game.foundationDamage);
+        framebufCopy(r->background, r->framebuffer);
+        r->backgroundConsts = consts;
+        r->backgroundDamage = frame->game.foundationDamage;
+    } else {
+        framebufCopy(r->framebuffer, r->background);
+    }
+    if (r->spriteConsts != consts) {
+        buildSprites(r, scene);
+    } else if (r->cannonVersion != scene->aimVersion) {
+        buildCannon(r, scene);
+    }
+    // Generate platform
+    if (r->platform.width) {
+        spriteBlit(r->framebuffer, &r->platform, fix16ToInt(objects[0].x), screenSize - 4);
+    } else {
+        platform.xMin = fix16ToInt(objects[0].x) - consts->platformConst.platformLength / 2;
+        platform.xMax = fix16ToInt(objects[0].x) + consts->platformConst.platformLength / 2;
+        platform.yMin = screenSize - 4;
+        platform.yMax = screenSize;
+        GLIB_drawRectFilled(r->glib, &platform);
+    }
+    // Draw Cannon 3 pixels thick
+    int32_t cannonX = fix16ToInt(objects[0].x);
+    if (r->cannon.width) {
+        spriteBlit(r->framebuffer, &r->cannon, cannonX, screenSize - 4);
+    } else {
+        for (int i = -1; i < 3; i++) {
+            GLIB_drawLine(r->glib, cannonX + r->cannonDx + i, screenSize - 4 + r->cannonDy, cannonX + i, screenSize - 4);
+        }
+    }
+    // Draw Projectiles
+    for (int i = 0; i < PHYSICS_MAX_OBJECTS; i++) {
+        if (objects[i].objectType == satchel) {
+            if (r->satchel.width) {
+                spriteBlit(r->framebuffer, &r->satchel, fix16ToInt(objects[i].x), screenSize - fix16ToInt(objects[i].y));
+            } else {
+                GLIB_drawCircleFilled(r->glib, fix16ToInt(objects[i].x), screenSize - fix16ToInt(objects[i].y), consts->satchelConst.satchelDisplayDiameter / 2);
+            }
+        } else if (objects[i].objectType == shot) {
+            if (r->shot.width) {
+                spriteBlit(r->framebuffer, &r->shot, fix16ToInt(objects[i].x), screenSize - fix16ToInt(objects[i].y));
+            } else {
+                GLIB_drawCircleFilled(r->glib, fix16ToInt(objects[i].x), screenSize - fix16ToInt(objects[i].y), consts->railGunConst.shotRadius);
+            }
+        }
+    }
+    // Remaining battery
+    battery.xMin = screenSize - 13;
+    battery.xMax = screenSize - 8;
+    battery.yMin = batteryTop(consts, &frame->game);
+    battery.yMax = 32;
+    GLIB_drawRectFilled(r->glib, &battery);
+    if (frame->game.shieldsActivated != r->shieldsDrawn) { // Draw shield once per activation
+        GLIB_drawCircle(r->glib, fix16ToInt(objects[0].x), screenSize - 4, consts->shieldConst.shieldEffectiveRange);
+        r->shieldsDrawn = frame->game.shieldsActivated;
+    }
+}
+
+static void drawGameOver(struct renderer *r, const struct gameFrame *frame)
+{
+    GLIB_clear(r->glib);
+    GLIB_drawStringOnLine(r->glib,
+                            "Game Over",
+                            0,
+                            GLIB_ALIGN_LEFT,
+                            5,
+                            5,
+                            true);
+    if (frame->game.state == fail || !frame->game.evacComplete) {
+        GLIB_drawStringOnLine(r->glib,
+                                "You Lost",
+                                2,
+                                GLIB_ALIGN_LEFT,
+                                5,
+                                15,
+                                true);
+    }
+    if (frame->game.state == win && !frame->game.evacComplete) {
+        GLIB_drawStringOnLine(r->glib,
+                                "The prisoners",
+                                4,
+                                GLIB_ALIGN_LEFT,
+                                5,
+                                25,
+                                true);
+        GLIB_drawStringOnLine(r->glib,
+                                "failed to evac",
+                                5,
+                                GLIB_ALIGN_LEFT,
+                                5,
+                                30,
+                                true);
+    } else if (frame->game.state == win) {
+        GLIB_drawStringOnLine(r->glib,
+                                "You Won",
+                                2,
+                                GLIB_ALIGN_LEFT,
+                                5,
+                                15,
+                                true);
+        GLIB_drawStringOnLine(r->glib,
+                                "The prisoners",
+                                4,
+                                GLIB_ALIGN_LEFT,
+                                5,
+                                25,
+                                true);
+        GLIB_drawStringOnLine(r->glib,
+                                "have escaped",
+                                5,
+                                GLIB_ALIGN_LEFT,
+                                5,
+                                30,
+                                true);
+    }
+    GLIB_drawStringOnLine(r->glib,
+                            "BTN0: restart",
+                            7,
+                            GLIB_ALIGN_LEFT,
+                            5,
+                            40,
+                            true);
+}
+
+// Copies the HUD over the top left corner, rasterizing it first for a new sample
+static void drawHud(struct renderer *r, const struct renderScene *scene)
+{
+    if (r->hudVersion != scene->hudVersion) {
+        perfHudDraw(r->hud, scene->hud);
+        r->hudVersion = scene->hudVersion;
+    }
+    int height = perfHudHeight(scene->hud);
+    for (int y = 0; y < height; y++) {
+        memcpy(&r->framebuffer[y * LCD_LINE_WORDS], &r->hud[y * PERF_HUD_WORDS], PERF_HUD_WORDS * sizeof(uint32_t));
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Draws the scene's screen into the framebuffer: the profile menu, the
+ *   game, or the game over screen, and the HUD over it if the scene has one.
+ ******************************************************************************/
+void renderDraw(struct renderer *r, const struct renderScene *scene)
+{
+    if (scene->frame->game.state == menu) {
+        drawMenu(r, scene->frame);
+    } else if (scene->frame->game.state == active) {
+        drawGame(r, scene);
+    } else {
+        drawGameOver(r, scene->frame);
+    }
+    if (scene->hud) {
+        drawHud(r, scene);
+    }
+}
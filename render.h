@@ -0,0 +1,62 @@
+/***************************************************************************//**
+ * @file
+ * @brief Draws the game's screens into the display framebuffer
+ *******************************************************************************
+ * Everything LCDDisplayTask puts on the panel, apart from the task itself so
+ * that it builds without Micrium or the board. On the target it draws with
+ * the SDK's GLIB into the DMD framebuffer; on the host host/glib_host.c
+ * stands in for GLIB and DMD, for PBM frame dumps and render benchmarks.
+ *
+ * The renderer caches what does not change from frame to frame: the game
+ * screen's background (when staticLayer is set), and the satchel, shot,
+ * platform and railgun barrel sprites (sprite.h), and the performance HUD
+ * (perfhud.h) between samples. renderHash() sums up a scene so the caller
+ * can skip frames that would come out the same.
+ ******************************************************************************/
+
+#ifndef RENDER_H
+#define RENDER_H
+#include <stdbool.h>
+#include <stdint.h>
+#include "glib.h"
+#include "angle.h"
+#include "framebuf.h"
+#include "perfhud.h"
+#include "physics.h"
+#include "snapshot.h"
+#include "sprite.h"
+
+struct renderScene {
+    const struct gameFrame *frame;
+    const struct physicsConstants *consts;
+    angle_t aim; // railgun aim
+    uint32_t aimVersion; // changes whenever aim does
+    const struct perfHudSample *hud; // drawn over the screen unless NULL
+    uint32_t hudVersion; // changes whenever *hud does
+};
+
+struct renderer {
+    GLIB_Context_t *glib;
+    uint32_t *framebuffer; // the one glib draws into
+    bool staticLayer; // start game frames as a copy of background instead of drawing it
+    int shieldsDrawn; // shieldsActivated of the last shield drawn; each is drawn for one frame
+    // The game screen's background, drawn once per profile and foundation damage
+    const struct physicsConstants *backgroundConsts;
+    int backgroundDamage;
+    uint32_t background[FRAMEBUF_WORDS];
+    // Rasterized once per profile, the barrel once per aim. A sprite with no width did not fit and
+    // is drawn with GLIB instead.
+    const struct physicsConstants *spriteConsts;
+    struct sprite satchel, shot, platform, cannon;
+    uint32_t cannonVersion; // aimVersion cannon was built for
+    int32_t cannonDx, cannonDy; // barrel end relative to its base
+    // The HUD, rasterized once per sample
+    uint32_t hudVersion;
+    uint32_t hud[PERF_HUD_HEIGHT * PERF_HUD_WORDS];
+};
+
+void renderInit(struct renderer *r, GLIB_Context_t *glib, void *framebuffer, bool staticLayer);
+uint32_t renderHash(const struct renderer *r, const struct renderScene *scene);
+void renderDraw(struct renderer *r, const struct renderScene *scene);
+
+#endif // RENDER_H
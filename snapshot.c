@@ -0,0 +1,123 @@
+/***************************************************************************//**
+ * @file
+ * @brief Lock-free published snapshot of the physics state
+ ******************************************************************************/
+
+#include <string.h>
+#include "snapshot.h"
+
+// The GCC __atomic builtins give the same ordering on the Cortex-M4 (dmb) and on a host build.
+
+// The last publish completed by sequence seq; its frame is in buffer[(published >> 1) & 1]
+static uint32_t publishedBy(uint32_t seq)
+{
+    return seq & ~1u;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Returns true if the copy of the frame published by sequence published may
+ *   be torn: the writer began the write after next, the first one into the
+ *   same buffer, before the copy was done.
+ ******************************************************************************/
+static bool readRetry(struct frameSnapshot *snap, uint32_t published)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE); // The copy's loads happen before the check
+    if (__atomic_load_n(&snap->sequence, __ATOMIC_RELAXED) - published >= 3) {
+        __atomic_fetch_add(&snap->readRetries, 1, __ATOMIC_RELAXED);
+        return true;
+    }
+    return false;
+}
+
+void snapshotInit(struct frameSnapshot *snap)
+{
+    memset(snap, 0, sizeof(*snap));
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Publishes a new frame. Single writer only; never blocks.
+ ******************************************************************************/
+void snapshotPublish(struct frameSnapshot *snap, const struct physicsData *objects, const struct objectPosition *previous,
+                     const struct gameData *game, uint32_t stateTime, uint32_t stepTicks)
+{
+    uint32_t seq = __atomic_load_n(&snap->sequence, __ATOMIC_RELAXED);
+    struct gameFrame *next = &snap->buffer[((seq >> 1) + 1) & 1u];
+    // Mark the write in progress, and make the mark visible before any of the data stores
+    __atomic_store_n(&snap->sequence, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(next->objects, objects, sizeof(next->objects));
+    memcpy(next->previous, previous, sizeof(next->previous));
+    next->game = *game;
+    next->stateTime = stateTime;
+    next->stepTicks = stepTicks;
+    next->tick = (seq >> 1) + 1;
+    // The data stores are visible before the flip
+    __atomic_store_n(&snap->sequence, seq + 2, __ATOMIC_RELEASE);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Copies the latest complete frame into out. Returns its publish count (the
+ *   frame's tick), which changes every publish, so callers can tell whether
+ *   anything is new.
+ ******************************************************************************/
+uint32_t snapshotRead(struct frameSnapshot *snap, struct gameFrame *out)
+{
+    uint32_t published;
+    do {
+        published = publishedBy(__atomic_load_n(&snap->sequence, __ATOMIC_ACQUIRE));
+        memcpy(out, &snap->buffer[(published >> 1) & 1u], sizeof(*out));
+    } while (readRetry(snap, published));
+    return published >> 1;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Same as snapshotRead() but only copies the game state, for the LED tasks.
+ ******************************************************************************/
+uint32_t snapshotReadGame(struct frameSnapshot *snap, struct gameData *out)
+{
+    uint32_t published;
+    do {
+        published = publishedBy(__atomic_load_n(&snap->sequence, __ATOMIC_ACQUIRE));
+        *out = snap->buffer[(published >> 1) & 1u].game;
+    } while (readRetry(snap, published));
+    return published >> 1;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Replaces each object's position with one blended from its previous position
+ *   by alpha (see stepAlpha()). Objects that appeared during the step are left
+ *   where they are.
+ ******************************************************************************/
+void snapshotInterpolate(struct gameFrame *frame, fix16_t alpha)
+{
+    for (int i = 0; i < PHYSICS_MAX_OBJECTS; i++) {
+        struct physicsData *obj = &frame->objects[i];
+        const struct objectPosition *prev = &frame->previous[i];
+        if (obj->objectType != empty && prev->objectType == obj->objectType) {
+            obj->x = fix16Lerp(prev->x, obj->x, alpha);
+            obj->y = fix16Lerp(prev->y, obj->y, alpha);
+        }
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Carries satchels seconds further along their ballistic paths. Used while
+ *   the physics task idles and no new frame arrives; satchels are then the
+ *   only thing moving and nothing can change their path before it wakes.
+ ******************************************************************************/
+void snapshotExtrapolate(struct gameFrame *frame, fix16_t seconds, fix16_t gravity)
+{
+    for (int i = 0; i < PHYSICS_MAX_OBJECTS; i++) {
+        struct physicsData *obj = &frame->objects[i];
+        if (obj->objectType == satchel) {
+            obj->x = fix16VerletStep(obj->x, obj->xVel, 0, seconds);
+            obj->y = fix16VerletStep(obj->y, obj->yVel, gravity, seconds);
+        }
+    }
+}
@@ -0,0 +1,43 @@
+/***************************************************************************//**
+ * @file
+ * @brief Lock-free published snapshot of the physics state
+ *******************************************************************************
+ * Double buffer under a sequence lock. The physics task is the only writer:
+ * each publish makes the sequence odd, fills the inactive buffer, and makes it
+ * even again, which flips the active buffer, never blocking. Readers (display,
+ * LEDs) copy the active buffer without a mutex and copy again if a write into
+ * that buffer may have begun meanwhile, i.e. once the sequence moved on by
+ * two writes. A reader never waits for the writer to finish, so it cannot
+ * deadlock on a preempted physics task. host/stress_snapshot checks that no
+ * read comes out torn.
+ ******************************************************************************/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+#include <stdint.h>
+#include "physics.h"
+
+struct gameFrame {
+    uint32_t tick; // publish count that produced this frame
+    uint32_t stateTime; // OS tick the objects correspond to
+    uint32_t stepTicks; // physics step length in OS ticks
+    struct physicsData objects[PHYSICS_MAX_OBJECTS];
+    struct objectPosition previous[PHYSICS_MAX_OBJECTS]; // one step before objects
+    struct gameData game;
+};
+
+struct frameSnapshot {
+    uint32_t sequence; // two per publish, odd while one is being written; buffer[(sequence >> 1) & 1] is published
+    uint32_t readRetries; // reads that had to start over, for diagnostics
+    struct gameFrame buffer[2];
+};
+
+void snapshotInit(struct frameSnapshot *snap);
+void snapshotPublish(struct frameSnapshot *snap, const struct physicsData *objects, const struct objectPosition *previous,
+                     const struct gameData *game, uint32_t stateTime, uint32_t stepTicks);
+uint32_t snapshotRead(struct frameSnapshot *snap, struct gameFrame *out);
+uint32_t snapshotReadGame(struct frameSnapshot *snap, struct gameData *out);
+void snapshotInterpolate(struct gameFrame *frame, fix16_t alpha);
+void snapshotExtrapolate(struct gameFrame *frame, fix16_t seconds, fix16_t gravity);
+
+#endif // SNAPSHOT_H
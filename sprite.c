@@ -0,0 +1,160 @@
+/***************************************************************************//**
+ * @file
+ * @brief Pre-rasterized 1bpp sprites for the memory LCD framebuffer
+ ******************************************************************************/
+
+#include <string.h>
+#include "framebuf.h"
+#include "sprite.h"
+
+static uint32_t spanMask(int x0, int x1)
+{
+    uint32_t upTo = x1 >= 31 ? UINT32_MAX : ((uint32_t)1 << (x1 + 1)) - 1;
+    return upTo & ~(((uint32_t)1 << x0) - 1);
+}
+
+// Both spans of row cy + dy, mirrored around cx
+static void circleRows(struct sprite *sprite, int cx, int dy, int halfWidth)
+{
+    uint32_t mask = spanMask(cx - halfWidth, cx + halfWidth);
+    sprite->rows[sprite->anchorY + dy] |= mask;
+    sprite->rows[sprite->anchorY - dy] |= mask;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Filled circle of the given radius, anchored at its center. Same
+ *   midpoint walk and spans as GLIB_drawCircleFilled().
+ ******************************************************************************/
+bool spriteCircle(struct sprite *sprite, int radius)
+{
+    memset(sprite, 0, sizeof(*sprite));
+    if (radius < 0 || 2 * radius + 1 > SPRITE_MAX_SIZE) {
+        return false;
+    }
+    sprite->width = sprite->height = (uint8_t)(2 * radius + 1);
+    sprite->anchorX = sprite->anchorY = (uint8_t)radius;
+    int x = 0, y = radius, d = 1 - radius;
+    circleRows(sprite, radius, x, y);
+    circleRows(sprite, radius, y, x);
+    while (x < y) {
+        if (d < 0) {
+            d += 2 * x + 3;
+        } else {
+            d += 2 * (x - y) + 5;
+            y--;
+        }
+        x++;
+        circleRows(sprite, radius, x, y);
+        circleRows(sprite, radius, y, x);
+    }
+    return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Blank width x height sprite with (anchorX, anchorY) at the blit position,
+ *   to draw into with spriteLine().
+ ******************************************************************************/
+bool spriteEmpty(struct sprite *sprite, int width, int height, int anchorX, int anchorY)
+{
+    memset(sprite, 0, sizeof(*sprite));
+    if (width < 1 || height < 1 || width > SPRITE_MAX_SIZE || height > SPRITE_MAX_SIZE ||
+        anchorX < 0 || anchorX >= width || anchorY < 0 || anchorY >= height) {
+        return false;
+    }
+    sprite->width = (uint8_t)width;
+    sprite->height = (uint8_t)height;
+    sprite->anchorX = (uint8_t)anchorX;
+    sprite->anchorY = (uint8_t)anchorY;
+    return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Filled width x height rectangle with (anchorX, anchorY) at the blit
+ *   position.
+ ******************************************************************************/
+bool spriteRect(struct sprite *sprite, int width, int height, int anchorX, int anchorY)
+{
+    if (!spriteEmpty(sprite, width, height, anchorX, anchorY)) {
+        return false;
+    }
+    for (int r = 0; r < height; r++) {
+        sprite->rows[r] = spanMask(0, width - 1);
+    }
+    return true;
+}
+
+static void spritePixel(struct sprite *sprite, int x, int y)
+{
+    x += sprite->anchorX;
+    y += sprite->anchorY;
+    if (x >= 0 && x < sprite->width && y >= 0 && y < sprite->height) {
+        sprite->rows[y] |= (uint32_t)1 << x;
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Adds the line from (x0, y0) to (x1, y1), relative to the anchor, to
+ *   sprite. Same Bresenham walk as GLIB_drawLine(); pixels outside the
+ *   sprite are dropped.
+ ******************************************************************************/
+void spriteLine(struct sprite *sprite, int x0, int y0, int x1, int y1)
+{
+    bool steep = (y1 > y0 ? y1 - y0 : y0 - y1) > (x1 > x0 ? x1 - x0 : x0 - x1);
+    int t;
+    if (steep) {
+        t = x0, x0 = y0, y0 = t;
+        t = x1, x1 = y1, y1 = t;
+    }
+    if (x0 > x1) {
+        t = x0, x0 = x1, x1 = t;
+        t = y0, y0 = y1, y1 = t;
+    }
+    int dx = x1 - x0;
+    int dy = y1 > y0 ? y1 - y0 : y0 - y1;
+    int step = y0 < y1 ? 1 : -1;
+    int error = dx / 2;
+    for (int x = x0, y = y0; x <= x1; x++) {
+        if (steep) {
+            spritePixel(sprite, y, x);
+        } else {
+            spritePixel(sprite, x, y);
+        }
+        error -= dy;
+        if (error < 0) {
+            y += step;
+            error += dx;
+        }
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Draws sprite with its anchor at (x, y). Each row is shifted into the one
+ *   or two framebuffer words it covers; words and rows off the screen are
+ *   skipped. framebuffer must be word aligned.
+ ******************************************************************************/
+void spriteBlit(uint32_t *framebuffer, const struct sprite *sprite, int x, int y)
+{
+    int left = x - sprite->anchorX;
+    int top = y - sprite->anchorY;
+    int word = (left - (left & 31)) / 32; // rounds down for negative left too
+    int shift = left & 31;
+    bool first = word >= 0 && word < LCD_LINE_WORDS;
+    bool second = word + 1 >= 0 && word + 1 < LCD_LINE_WORDS;
+    int r0 = top < 0 ? -top : 0;
+    int r1 = top + sprite->height > LCD_HEIGHT ? LCD_HEIGHT - top : sprite->height;
+    for (int r = r0; r < r1; r++) {
+        uint32_t *line = framebuffer + (top + r) * LCD_LINE_WORDS;
+        uint64_t ink = (uint64_t)sprite->rows[r] << shift;
+        if (first) {
+            line[word] &= ~(uint32_t)ink;
+        }
+        if (second) {
+            line[word + 1] &= ~(uint32_t)(ink >> 32);
+        }
+    }
+}
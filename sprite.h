@@ -0,0 +1,35 @@
+/***************************************************************************//**
+ * @file
+ * @brief Pre-rasterized 1bpp sprites for the memory LCD framebuffer
+ *******************************************************************************
+ * Satchels, shots and the platform have the same shape every frame, and the
+ * railgun barrel keeps its shape until the aim changes, so they are
+ * rasterized once into one 32-bit mask per row. Drawing one is then a shift
+ * and a masked write of one or two words per row, clipped at the screen
+ * edges, instead of GLIB working out the shape pixel by pixel. Circles match
+ * GLIB_drawCircleFilled() and lines GLIB_drawLine() pixel for pixel. Ink is
+ * black, a cleared framebuffer bit.
+ ******************************************************************************/
+
+#ifndef SPRITE_H
+#define SPRITE_H
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SPRITE_MAX_SIZE 32 // pixels each way; one row is one word
+
+struct sprite {
+    uint8_t width; // 0 when the shape did not fit; draw it some other way
+    uint8_t height;
+    uint8_t anchorX; // pixel of the sprite placed at the position given to spriteBlit()
+    uint8_t anchorY;
+    uint32_t rows[SPRITE_MAX_SIZE]; // bit i is column i, as in the framebuffer
+};
+
+bool spriteCircle(struct sprite *sprite, int radius);
+bool spriteRect(struct sprite *sprite, int width, int height, int anchorX, int anchorY);
+bool spriteEmpty(struct sprite *sprite, int width, int height, int anchorX, int anchorY);
+void spriteLine(struct sprite *sprite, int x0, int y0, int x1, int y1);
+void spriteBlit(uint32_t *framebuffer, const struct sprite *sprite, int x, int y);
+
+#endif // SPRITE_H
@@ -0,0 +1,91 @@
+/***************************************************************************//**
+ * @file
+ * @brief Fixed-timestep accumulator driven by a monotonic tick count
+ ******************************************************************************/
+
+#include "timestep.h"
+
+void stepInit(struct fixedStep *fs, uint32_t stepTicks, uint32_t maxCatchUp, uint32_t now)
+{
+    fs->stepTicks = stepTicks ? stepTicks : 1;
+    fs->maxCatchUp = maxCatchUp ? maxCatchUp : 1;
+    fs->lastTime = now;
+    fs->accumulator = 0;
+    fs->stateTime = now;
+    fs->steps = 0;
+    fs->catchUpSteps = 0;
+    fs->droppedSteps = 0;
+    fs->skippedSteps = 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Adds the time since the last call and returns how many steps to run now.
+ *   Tick counter wrap-around is handled by the unsigned subtraction.
+ ******************************************************************************/
+uint32_t stepAdvance(struct fixedStep *fs, uint32_t now)
+{
+    fs->accumulator += now - fs->lastTime;
+    fs->lastTime = now;
+    uint32_t due = fs->accumulator / fs->stepTicks;
+    if (due > fs->maxCatchUp) {
+        fs->droppedSteps += due - fs->maxCatchUp;
+        due = fs->maxCatchUp;
+        fs->accumulator = 0; // Resynchronize instead of carrying the stall forward
+    } else {
+        fs->accumulator -= due * fs->stepTicks;
+    }
+    if (due > 1) {
+        fs->catchUpSteps += due - 1;
+    }
+    fs->steps += due;
+    fs->stateTime = now - fs->accumulator;
+    return due;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Takes up to maxSteps steps that fell due while the caller slept, for it to
+ *   fast-forward instead of run. Anything beyond is left for stepAdvance().
+ ******************************************************************************/
+uint32_t stepSkip(struct fixedStep *fs, uint32_t now, uint32_t maxSteps)
+{
+    fs->accumulator += now - fs->lastTime;
+    fs->lastTime = now;
+    uint32_t due = fs->accumulator / fs->stepTicks;
+    if (due > maxSteps) {
+        due = maxSteps;
+    }
+    fs->accumulator -= due * fs->stepTicks;
+    fs->steps += due;
+    fs->skippedSteps += due;
+    fs->stateTime = now - fs->accumulator;
+    return due;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Ticks to sleep before the next step is due, at least one.
+ ******************************************************************************/
+uint32_t stepTicksUntilDue(const struct fixedStep *fs, uint32_t now)
+{
+    uint32_t owed = fs->accumulator + (now - fs->lastTime);
+    if (owed >= fs->stepTicks) {
+        return 1;
+    }
+    return fs->stepTicks - owed;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Interpolation factor in [0, 1] between the previous and the current state,
+ *   rendering one step behind the simulation.
+ ******************************************************************************/
+fix16_t stepAlpha(uint32_t stateTime, uint32_t stepTicks, uint32_t now)
+{
+    uint32_t elapsed = now - stateTime;
+    if (stepTicks == 0 || elapsed >= stepTicks) {
+        return FIX16_ONE;
+    }
+    return fix16FromFrac((int32_t)elapsed, (int32_t)stepTicks);
+}
@@ -0,0 +1,36 @@
+/***************************************************************************//**
+ * @file
+ * @brief Fixed-timestep accumulator driven by a monotonic tick count
+ *******************************************************************************
+ * The physics task feeds the current OS tick in and gets back how many fixed
+ * steps are due. Falling behind produces catch-up steps, capped so a long stall
+ * cannot snowball; time beyond the cap is dropped and counted. The display
+ * uses stepAlpha() to interpolate between the last two published states.
+ * While nothing moves the caller can sleep through several steps and account
+ * for them with stepSkip() instead of running them.
+ ******************************************************************************/
+
+#ifndef TIMESTEP_H
+#define TIMESTEP_H
+#include <stdint.h>
+#include "fixedpoint.h"
+
+struct fixedStep {
+    uint32_t stepTicks; // length of one physics step in OS ticks
+    uint32_t maxCatchUp; // most steps run back to back before dropping time
+    uint32_t lastTime; // tick count at the last stepAdvance()
+    uint32_t accumulator; // ticks owed to the simulation, less than stepTicks after a call
+    uint32_t stateTime; // tick count the latest simulated state corresponds to
+    uint32_t steps; // total steps handed out
+    uint32_t catchUpSteps; // steps beyond the first in a single call
+    uint32_t droppedSteps; // steps skipped because of the catch-up cap
+    uint32_t skippedSteps; // steps fast-forwarded by stepSkip() while the game was idle
+};
+
+void stepInit(struct fixedStep *fs, uint32_t stepTicks, uint32_t maxCatchUp, uint32_t now);
+uint32_t stepAdvance(struct fixedStep *fs, uint32_t now);
+uint32_t stepSkip(struct fixedStep *fs, uint32_t now, uint32_t maxSteps);
+uint32_t stepTicksUntilDue(const struct fixedStep *fs, uint32_t now);
+fix16_t stepAlpha(uint32_t stateTime, uint32_t stepTicks, uint32_t now);
+
+#endif // TIMESTEP_H
@@ -0,0 +1,97 @@
+/***************************************************************************//**
+ * @file
+ * @brief Closed-form ballistic trajectories
+ ******************************************************************************/
+
+#include "trajectory.h"
+
+// Integer square root, bit by bit. Only run when a trajectory starts.
+static uint32_t isqrt64(uint64_t value)
+{
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+void trajectoryStart(struct trajectory *path, fix16_t time, fix16_t x, fix16_t y, fix16_t xVel, fix16_t yVel)
+{
+    path->startTime = time;
+    path->x0 = x;
+    path->y0 = y;
+    path->xVel = xVel;
+    path->yVel = yVel;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Position and velocity at an absolute time. Any output pointer may be NULL.
+ ******************************************************************************/
+void trajectoryEval(const struct trajectory *path, fix16_t gravity, fix16_t time,
+                    fix16_t *x, fix16_t *y, fix16_t *xVel, fix16_t *yVel)
+{
+    fix16_t t = time - path->startTime;
+    if (x) {
+        *x = path->x0 + fix16Mul(path->xVel, t);
+    }
+    if (y) {
+        // y0 + vy * t + g * t^2 / 2
+        *y = path->y0 + fix16Mul(path->yVel, t) + fix16Mul(gravity, fix16Mul(t, t)) / 2;
+    }
+    if (xVel) {
+        *xVel = path->xVel;
+    }
+    if (yVel) {
+        *yVel = path->yVel + fix16Mul(gravity, t);
+    }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Absolute time at which the trajectory comes down through height, or
+ *   TRAJECTORY_NEVER. gravity must be negative.
+ ******************************************************************************/
+fix16_t trajectoryTimeToHeight(const struct trajectory *path, fix16_t gravity, fix16_t height)
+{
+    if (gravity >= 0) {
+        return TRAJECTORY_NEVER;
+    }
+    // (g/2) t^2 + vy t + (y0 - h) = 0, descending root t = (-vy - sqrt(vy^2 - 2 g (y0 - h))) / g
+    // Both terms of the discriminant are Q32.32.
+    int64_t disc = (int64_t)path->yVel * path->yVel - 2 * (int64_t)gravity * (path->y0 - height);
+    if (disc < 0) {
+        return TRAJECTORY_NEVER;
+    }
+    fix16_t root = (fix16_t)isqrt64((uint64_t)disc);
+    fix16_t t = fix16Div(-path->yVel - root, gravity);
+    if (t < 0) {
+        t = 0; // Already below height
+    }
+    return path->startTime + t;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Absolute time at which the trajectory reaches x, or TRAJECTORY_NEVER if it
+ *   starts there or is moving away. A path that starts on a wall after
+ *   bouncing off it never hits it again.
+ ******************************************************************************/
+fix16_t trajectoryTimeToX(const struct trajectory *path, fix16_t x)
+{
+    fix16_t distance = x - path->x0;
+    if (distance == 0 || path->xVel == 0 || (distance > 0) != (path->xVel > 0)) {
+        return TRAJECTORY_NEVER;
+    }
+    return path->startTime + fix16Div(distance, path->xVel);
+}
@@ -0,0 +1,32 @@
+/***************************************************************************//**
+ * @file
+ * @brief Closed-form ballistic trajectories
+ *******************************************************************************
+ * A trajectory is a start time plus initial position and velocity under
+ * constant gravity. Position at any time is evaluated directly, and the times
+ * at which it reaches a height or a wall are solved once, so nothing has to be
+ * integrated step by step.
+ ******************************************************************************/
+
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+#include <stdint.h>
+#include "fixedpoint.h"
+
+#define TRAJECTORY_NEVER FIX16_MAX
+
+struct trajectory {
+    fix16_t startTime; // s
+    fix16_t x0;
+    fix16_t y0;
+    fix16_t xVel;
+    fix16_t yVel;
+};
+
+void trajectoryStart(struct trajectory *path, fix16_t time, fix16_t x, fix16_t y, fix16_t xVel, fix16_t yVel);
+void trajectoryEval(const struct trajectory *path, fix16_t gravity, fix16_t time,
+                    fix16_t *x, fix16_t *y, fix16_t *xVel, fix16_t *yVel);
+fix16_t trajectoryTimeToHeight(const struct trajectory *path, fix16_t gravity, fix16_t height);
+fix16_t trajectoryTimeToX(const struct trajectory *path, fix16_t x);
+
+#endif // TRAJECTORY_H